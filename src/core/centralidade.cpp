@@ -0,0 +1,385 @@
+#include "centralidade.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+// Área de trabalho de uma thread, reaproveitada entre as origens
+struct AreaBrandes
+{
+    vector<Custo> dist;
+    vector<double> sigma;     // Número de caminhos mínimos a partir da origem
+    vector<double> delta;     // Dependência acumulada
+    vector<int> ordem;        // Vértices na ordem em que foram fechados
+    vector<pair<Custo, int>> heap;
+    vector<double> acumulado; // Intermediação parcial desta thread
+};
+
+static void acumularOrigem(const GrafoCSR &grafo, int origem, AreaBrandes &area)
+{
+    auto &dist = area.dist;
+    auto &sigma = area.sigma;
+    auto &delta = area.delta;
+    auto &ordem = area.ordem;
+    auto &heap = area.heap;
+
+    // Só os vértices alcançados são reinicializados ao final
+    ordem.clear();
+    heap.clear();
+
+    dist[origem] = 0;
+    sigma[origem] = 1;
+    heap.push_back({0, origem});
+
+    while (!heap.empty())
+    {
+        pop_heap(heap.begin(), heap.end(), greater<pair<Custo, int>>());
+        auto [d, u] = heap.back();
+        heap.pop_back();
+
+        if (d > dist[u] || delta[u] < 0)
+        {
+            continue; // Entrada obsoleta ou vértice já fechado
+        }
+        delta[u] = -1; // Marca como fechado (zerado antes da fase de acumulação)
+        ordem.push_back(u);
+
+        for (int e = grafo.inicio[u]; e < grafo.inicio[u + 1]; e++)
+        {
+            int v = grafo.destinos[e];
+            Custo nova_dist = d + grafo.pesos[e];
+            if (nova_dist < dist[v])
+            {
+                dist[v] = nova_dist;
+                sigma[v] = sigma[u];
+                heap.push_back({nova_dist, v});
+                push_heap(heap.begin(), heap.end(), greater<pair<Custo, int>>());
+            }
+            else if (nova_dist == dist[v])
+            {
+                sigma[v] += sigma[u];
+            }
+        }
+    }
+
+    for (int v : ordem)
+    {
+        delta[v] = 0;
+    }
+
+    // Acumulação das dependências em ordem inversa de distância
+    for (auto it = ordem.rbegin(); it != ordem.rend(); ++it)
+    {
+        int v = *it;
+        for (int e = grafo.inicio[v]; e < grafo.inicio[v + 1]; e++)
+        {
+            int w = grafo.destinos[e];
+            if (dist[v] + grafo.pesos[e] == dist[w])
+            {
+                delta[v] += sigma[v] / sigma[w] * (1.0 + delta[w]);
+            }
+        }
+        if (v != origem)
+        {
+            area.acumulado[v] += delta[v];
+        }
+    }
+
+    for (int v : ordem)
+    {
+        dist[v] = CUSTO_INFINITO;
+        sigma[v] = 0;
+        delta[v] = 0;
+    }
+}
+
+// Com uma ligação de custo zero, vértices à mesma distância podem depender uns
+// dos outros (e uma aresta de custo zero já forma um ciclo de custo zero): as
+// contagens de caminhos mínimos deixam de estar definidas e o Dijkstra somaria
+// sigma em vértices já fechados. GrafoCSR::construir só rejeita custos negativos.
+static void exigirCustosPositivos(const GrafoCSR &grafo)
+{
+    for (int u = 1; u <= grafo.num_vertices; u++)
+    {
+        for (int e = grafo.inicio[u]; e < grafo.inicio[u + 1]; e++)
+        {
+            if (grafo.pesos[e] <= 0)
+            {
+                throw runtime_error("Intermediação exige custos positivos: ligação (" + to_string(u) + "," +
+                                    to_string(grafo.destinos[e]) + ") tem custo " + to_string(grafo.pesos[e]));
+            }
+        }
+    }
+}
+
+vector<double> intermediacaoBrandes(const GrafoCSR &grafo, int num_threads)
+{
+    exigirCustosPositivos(grafo);
+    const int n = grafo.num_vertices;
+    num_threads = max(1, min(num_threads, n));
+
+    vector<AreaBrandes> areas(num_threads);
+    for (auto &area : areas)
+    {
+        area.dist.assign(n + 1, CUSTO_INFINITO);
+        area.sigma.assign(n + 1, 0.0);
+        area.delta.assign(n + 1, 0.0);
+        area.acumulado.assign(n + 1, 0.0);
+        area.ordem.reserve(n);
+    }
+
+    // Divisão estática em faixas contíguas de origens: para um mesmo número de
+    // threads, a ordem das somas (e portanto o resultado) é sempre a mesma
+    executarEmThreads(num_threads, [&](int id)
+    {
+        int inicio = 1 + static_cast<long long>(n) * id / num_threads;
+        int fim = 1 + static_cast<long long>(n) * (id + 1) / num_threads;
+        for (int origem = inicio; origem < fim; origem++)
+        {
+            acumularOrigem(grafo, origem, areas[id]);
+        }
+    });
+
+    vector<double> intermediacao(n + 1, 0.0);
+    for (const auto &area : areas)
+    {
+        for (int v = 1; v <= n; v++)
+        {
+            intermediacao[v] += area.acumulado[v];
+        }
+    }
+
+    return intermediacao;
+}
+
+// Gerador splitmix64: cada amostra tem seu próprio fluxo, derivado da semente e
+// do índice da amostra, para que o resultado não dependa da divisão entre threads
+struct GeradorAmostra
+{
+    unsigned long long estado;
+
+    GeradorAmostra(unsigned long long semente, long long indice)
+        : estado(semente ^ (0xD1B54A32D192ED03ULL * static_cast<unsigned long long>(indice + 1))) {}
+
+    unsigned long long proximo()
+    {
+        unsigned long long z = (estado += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Inteiro em [0, limite)
+    int inteiro(int limite) { return static_cast<int>(proximo() % static_cast<unsigned long long>(limite)); }
+
+    // Real em [0, 1)
+    double uniforme() { return (proximo() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+// Área de trabalho de uma thread na amostragem
+struct AreaAmostragem
+{
+    vector<Custo> dist;
+    vector<double> sigma;
+    vector<char> fechado;
+    vector<int> tocados;           // Vértices com distância finita, reinicializados a cada amostra
+    vector<pair<Custo, int>> heap;
+    vector<long long> contagem;    // Vezes em que cada vértice foi interno ao caminho sorteado
+};
+
+// Sorteia um par (s,t), conta os caminhos mínimos a partir de s até fechar t e
+// percorre de t para s um caminho mínimo escolhido uniformemente: cada
+// predecessor p de w é escolhido com probabilidade sigma[p] / sigma[w]
+static void amostrarPar(const GrafoCSR &grafo, const GrafoCSR &reverso, unsigned long long semente,
+                        long long indice, AreaAmostragem &area)
+{
+    const int n = grafo.num_vertices;
+    auto &dist = area.dist;
+    auto &sigma = area.sigma;
+    auto &fechado = area.fechado;
+    auto &tocados = area.tocados;
+    auto &heap = area.heap;
+
+    GeradorAmostra gerador(semente, indice);
+    int s = 1 + gerador.inteiro(n);
+    int t = 1 + gerador.inteiro(n - 1);
+    if (t >= s)
+    {
+        t++;
+    }
+
+    dist[s] = 0;
+    sigma[s] = 1;
+    tocados.push_back(s);
+    heap.push_back({0, s});
+
+    while (!heap.empty())
+    {
+        pop_heap(heap.begin(), heap.end(), greater<pair<Custo, int>>());
+        auto [d, u] = heap.back();
+        heap.pop_back();
+
+        if (d > dist[u] || fechado[u])
+        {
+            continue;
+        }
+        fechado[u] = 1;
+
+        // Os predecessores de t estão mais próximos de s, logo já fechados
+        if (u == t)
+        {
+            break;
+        }
+
+        for (int e = grafo.inicio[u]; e < grafo.inicio[u + 1]; e++)
+        {
+            int v = grafo.destinos[e];
+            Custo nova_dist = d + grafo.pesos[e];
+            if (nova_dist < dist[v])
+            {
+                if (dist[v] == CUSTO_INFINITO)
+                {
+                    tocados.push_back(v);
+                }
+                dist[v] = nova_dist;
+                sigma[v] = sigma[u];
+                heap.push_back({nova_dist, v});
+                push_heap(heap.begin(), heap.end(), greater<pair<Custo, int>>());
+            }
+            else if (nova_dist == dist[v])
+            {
+                sigma[v] += sigma[u];
+            }
+        }
+    }
+
+    // Par sem caminho: a amostra conta, mas não credita ninguém
+    if (fechado[t])
+    {
+        int w = t;
+        while (w != s)
+        {
+            double alvo = gerador.uniforme() * sigma[w];
+            int escolhido = -1;
+            for (int e = reverso.inicio[w]; e < reverso.inicio[w + 1]; e++)
+            {
+                int p = reverso.destinos[e];
+                if (fechado[p] && dist[p] + reverso.pesos[e] == dist[w])
+                {
+                    escolhido = p;
+                    alvo -= sigma[p];
+                    if (alvo < 0)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            w = escolhido;
+            if (w != s)
+            {
+                area.contagem[w]++;
+            }
+        }
+    }
+
+    for (int v : tocados)
+    {
+        dist[v] = CUSTO_INFINITO;
+        sigma[v] = 0;
+        fechado[v] = 0;
+    }
+    tocados.clear();
+    heap.clear();
+}
+
+// Limite de Riondato & Kornaropoulos com c = 0,5 e VD <= n
+static double termoLimite(int num_vertices, double delta)
+{
+    return floor(log2(max(num_vertices - 2, 1))) + 1 + log(1.0 / delta);
+}
+
+long long amostrasNecessarias(int num_vertices, double epsilon, double delta)
+{
+    if (epsilon <= 0 || delta <= 0 || delta >= 1)
+    {
+        throw runtime_error("Parâmetros de amostragem inválidos: exige epsilon > 0 e 0 < delta < 1");
+    }
+    if (num_vertices < 3)
+    {
+        return 0; // Nenhum caminho tem vértice interno
+    }
+    return static_cast<long long>(ceil(0.5 * termoLimite(num_vertices, delta) / (epsilon * epsilon)));
+}
+
+ResultadoAmostragem intermediacaoAmostrada(const GrafoCSR &grafo, const ParametrosAmostragem &parametros,
+                                           int num_threads)
+{
+    exigirCustosPositivos(grafo);
+    const int n = grafo.num_vertices;
+    ResultadoAmostragem resultado;
+    resultado.intermediacao.assign(n + 1, 0.0);
+    resultado.amostras_previstas = amostrasNecessarias(n, parametros.epsilon, parametros.delta);
+    resultado.amostras_realizadas = 0;
+    resultado.epsilon_obtido = 0.0;
+
+    if (resultado.amostras_previstas == 0)
+    {
+        return resultado;
+    }
+    const double termo = termoLimite(n, parametros.delta);
+
+    const GrafoCSR reverso = grafo.transposto();
+
+    num_threads = max(1, num_threads);
+    vector<AreaAmostragem> areas(num_threads);
+    for (auto &area : areas)
+    {
+        area.dist.assign(n + 1, CUSTO_INFINITO);
+        area.sigma.assign(n + 1, 0.0);
+        area.fechado.assign(n + 1, 0);
+        area.contagem.assign(n + 1, 0);
+    }
+
+    // Lotes de tamanho fixo: o tempo limite só é verificado entre lotes, de modo
+    // que as amostras realizadas são sempre um prefixo da sequência sorteada
+    const long long TAMANHO_LOTE = 1024;
+    auto inicio = chrono::steady_clock::now();
+    long long realizadas = 0;
+
+    while (realizadas < resultado.amostras_previstas)
+    {
+        const long long base = realizadas;
+        const int lote = static_cast<int>(min(TAMANHO_LOTE, resultado.amostras_previstas - realizadas));
+        paraleloPara(0, lote, num_threads, [&](int i, int id)
+        {
+            amostrarPar(grafo, reverso, parametros.semente, base + i, areas[id]);
+        });
+        realizadas += lote;
+
+        chrono::duration<double> decorrido = chrono::steady_clock::now() - inicio;
+        if (parametros.tempo_limite > 0 && decorrido.count() >= parametros.tempo_limite)
+        {
+            break;
+        }
+    }
+
+    // Contagens inteiras: a soma entre threads é exata e independe da ordem
+    const double escala = static_cast<double>(n) * (n - 1) / realizadas;
+    for (int v = 1; v <= n; v++)
+    {
+        long long total = 0;
+        for (const auto &area : areas)
+        {
+            total += area.contagem[v];
+        }
+        resultado.intermediacao[v] = total * escala;
+    }
+
+    resultado.amostras_realizadas = realizadas;
+    resultado.epsilon_obtido = sqrt(0.5 * termo / realizadas);
+
+    return resultado;
+}
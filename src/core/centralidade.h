@@ -0,0 +1,56 @@
+#ifndef CENTRALIDADE_H
+#define CENTRALIDADE_H
+
+#include "grafo_csr.h"
+#include "paralelo.h"
+#include <vector>
+
+using namespace std;
+
+// Centralidade de intermediação pelo algoritmo de Brandes (variante com pesos):
+// para cada origem s, um Dijkstra conta os caminhos mínimos sigma[v] e, na
+// ordem inversa de fechamento, acumula as dependências
+//     delta[v] = soma sobre w com v -> w mínimo de sigma[v] / sigma[w] * (1 + delta[w]).
+// O resultado (índice = vértice) é a soma, sobre pares ordenados (s,t), da fração
+// dos caminhos mínimos de s a t que passam por v, dividindo o crédito entre
+// caminhos empatados. Custo O(n·m log n); as origens são divididas entre as
+// threads, cada uma com seu acumulador, somados ao final. Exige custos positivos:
+// lança runtime_error se alguma ligação tiver custo zero.
+vector<double> intermediacaoBrandes(const GrafoCSR &grafo, int num_threads = obterNumThreads());
+
+// Parâmetros da intermediação aproximada
+struct ParametrosAmostragem
+{
+    double epsilon;                 // Erro absoluto máximo na escala normalizada (dividida por n(n-1))
+    double delta;                   // Probabilidade máxima de o erro passar de epsilon
+    double tempo_limite;            // Em segundos; 0 = sem limite
+    unsigned long long semente;     // Mesma semente => mesmo resultado, com qualquer número de threads
+
+    ParametrosAmostragem() : epsilon(0.01), delta(0.1), tempo_limite(0.0), semente(42) {}
+};
+
+struct ResultadoAmostragem
+{
+    vector<double> intermediacao;   // Mesma escala de intermediacaoBrandes
+    long long amostras_previstas;   // Pares necessários para garantir epsilon
+    long long amostras_realizadas;  // Menor que o previsto se o tempo limite foi atingido
+    double epsilon_obtido;          // Erro garantido (com prob. 1 - delta) pelas amostras realizadas
+};
+
+// Intermediação aproximada por amostragem de pares (Riondato & Kornaropoulos):
+// sorteia r pares (s,t), escolhe um caminho mínimo de s a t uniformemente entre
+// os empatados e credita 1/r a cada vértice interno. Com
+//     r = ceil(0,5 / epsilon² · (floor(log2(VD - 2)) + 1 + ln(1/delta)))
+// o erro de todos os vértices fica abaixo de epsilon com probabilidade 1 - delta.
+// VD (máximo de vértices em um caminho mínimo) é limitado por n, o que vale
+// também para grafos com pesos e direcionados. Cada Dijkstra para ao fechar t.
+// Com tempo_limite, as amostras são feitas em lotes e o erro obtido é
+// recalculado para o número de pares efetivamente sorteados. Também exige custos
+// positivos (runtime_error com ligação de custo zero).
+// Número de pares que garante o erro epsilon com probabilidade 1 - delta
+long long amostrasNecessarias(int num_vertices, double epsilon, double delta);
+
+ResultadoAmostragem intermediacaoAmostrada(const GrafoCSR &grafo, const ParametrosAmostragem &parametros,
+                                           int num_threads = obterNumThreads());
+
+#endif // CENTRALIDADE_H
@@ -0,0 +1,32 @@
+#ifndef CUSTO_H
+#define CUSTO_H
+
+#include <cstdint>
+#include <limits>
+
+using namespace std;
+
+// Custos de travessia e de serviço das instâncias (sempre inteiros)
+typedef int32_t Custo;
+
+// Sentinela de "sem caminho" para cada tipo de distância. Vale metade do maior
+// valor do tipo: a soma de duas distâncias quaisquer (inclusive infinitas) nunca
+// transborda, e qualquer soma >= INFINITO continua sendo tratada como infinita.
+// Assim o kernel min-plus compara somas diretamente, sem testes de estouro.
+template <typename T>
+struct LimitesCusto
+{
+    static constexpr T INFINITO = numeric_limits<T>::max() / 2;
+};
+
+constexpr Custo CUSTO_INFINITO = LimitesCusto<Custo>::INFINITO;
+
+// Soma saturada em INFINITO (para acumular custos fora dos kernels)
+template <typename T>
+inline T somarCustos(T a, T b)
+{
+    long long soma = static_cast<long long>(a) + b;
+    return soma >= LimitesCusto<T>::INFINITO ? LimitesCusto<T>::INFINITO : static_cast<T>(soma);
+}
+
+#endif // CUSTO_H
@@ -0,0 +1,157 @@
+#include "dijkstra.h"
+#include "heap_radix.h"
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+
+// Alvos opcionais de uma busca: a busca termina assim que todos os vértices
+// com marcador_alvo[v] >= 0 forem definitivamente rotulados
+struct AlvosBusca
+{
+    const int *marcador_alvo;
+    int num_alvos;
+};
+
+static const AlvosBusca SEM_ALVOS = {nullptr, 0};
+
+// Dijkstra com heap radix sobre os custos inteiros não negativos do grafo.
+// Só os vértices rotulados definitivamente têm dist escrita; a busca termina
+// cedo quando todos os alvos (se houver) forem rotulados.
+template <typename T>
+static void dijkstraOrigem(const GrafoCSR &grafo, int origem, T *dist, T *pred, vector<uint64_t> &dist_provisoria,
+                           HeapRadix &heap, AlvosBusca alvos = SEM_ALVOS)
+{
+    fill(dist_provisoria.begin(), dist_provisoria.end(), numeric_limits<uint64_t>::max());
+    dist_provisoria[origem] = 0;
+    pred[origem] = origem;
+
+    heap.limpar();
+    heap.inserir(0, origem);
+    int alvos_restantes = alvos.num_alvos;
+
+    while (!heap.vazio())
+    {
+        auto [d, u] = heap.extrairMinimo();
+        if (d > dist_provisoria[u])
+        {
+            continue;
+        }
+        dist[u] = static_cast<T>(d);
+        if (alvos.marcador_alvo != nullptr && alvos.marcador_alvo[u] >= 0 && --alvos_restantes == 0)
+        {
+            return;
+        }
+
+        for (int e = grafo.inicio[u]; e < grafo.inicio[u + 1]; e++)
+        {
+            int v = grafo.destinos[e];
+            uint64_t nova_dist = d + static_cast<uint64_t>(grafo.pesos[e]);
+            if (nova_dist < dist_provisoria[v])
+            {
+                dist_provisoria[v] = nova_dist;
+                pred[v] = u;
+                heap.inserir(nova_dist, v);
+            }
+        }
+    }
+}
+
+// Área de trabalho de uma thread, reaproveitada entre as origens
+struct AreaDijkstra
+{
+    HeapRadix heap;
+    vector<uint64_t> dist_provisoria;
+    vector<Custo> dist;
+    vector<Custo> pred;
+};
+
+template <typename T>
+void dijkstraTodosPares(const GrafoCSR &grafo, MatrizDensa<T> &dist, MatrizDensa<T> &pred, int num_threads)
+{
+    const int n = grafo.num_vertices;
+    const size_t passo_dist = dist.getPasso();
+    const size_t passo_pred = pred.getPasso();
+
+    num_threads = max(1, min(num_threads, n));
+    vector<AreaDijkstra> areas(num_threads);
+
+    paraleloPara(1, n + 1, num_threads, [&](int origem, int id_thread)
+    {
+        T *dist_s = dist[origem];
+        T *pred_s = pred[origem];
+        fill(dist_s, dist_s + passo_dist, LimitesCusto<T>::INFINITO);
+        fill(pred_s, pred_s + passo_pred, static_cast<T>(-1));
+
+        AreaDijkstra &area = areas[id_thread];
+        area.dist_provisoria.resize(n + 1);
+        dijkstraOrigem(grafo, origem, dist_s, pred_s, area.dist_provisoria, area.heap);
+    });
+}
+
+template void dijkstraTodosPares<int32_t>(const GrafoCSR &, MatrizDensa<int32_t> &, MatrizDensa<int32_t> &, int);
+template void dijkstraTodosPares<int16_t>(const GrafoCSR &, MatrizDensa<int16_t> &, MatrizDensa<int16_t> &, int);
+
+void dijkstraTerminais(const GrafoCSR &grafo, const vector<int> &terminais, MatrizDensa<Custo> &dist_terminais,
+                       int num_threads)
+{
+    const int n = grafo.num_vertices;
+    const int k = terminais.size();
+
+    vector<int> indice_terminal(n + 1, -1);
+    for (int t = 0; t < k; t++)
+    {
+        indice_terminal[terminais[t]] = t;
+    }
+    AlvosBusca alvos = {indice_terminal.data(), k};
+
+    num_threads = max(1, min(num_threads, k));
+    vector<AreaDijkstra> areas(num_threads);
+
+    dist_terminais = MatrizDensa<Custo>(k, k, CUSTO_INFINITO);
+
+    paraleloPara(0, k, num_threads, [&](int t, int id_thread)
+    {
+        AreaDijkstra &area = areas[id_thread];
+        area.dist.assign(n + 1, CUSTO_INFINITO);
+        area.pred.assign(n + 1, -1);
+        area.dist_provisoria.resize(n + 1);
+
+        // A busca para assim que todos os terminais forem alcançados
+        dijkstraOrigem(grafo, terminais[t], area.dist.data(), area.pred.data(), area.dist_provisoria, area.heap, alvos);
+
+        Custo *linha = dist_terminais[t];
+        for (int u = 0; u < k; u++)
+        {
+            linha[u] = area.dist[terminais[u]];
+        }
+    });
+}
+
+Custo dijkstraCaminho(const GrafoCSR &grafo, int origem, int destino, vector<int> &caminho)
+{
+    const int n = grafo.num_vertices;
+    vector<Custo> dist(n + 1, CUSTO_INFINITO);
+    vector<Custo> pred(n + 1, -1);
+    vector<uint64_t> dist_provisoria(n + 1);
+    vector<int> marcador(n + 1, -1);
+    marcador[destino] = 0;
+
+    HeapRadix heap;
+    dijkstraOrigem(grafo, origem, dist.data(), pred.data(), dist_provisoria, heap, {marcador.data(), 1});
+
+    caminho.clear();
+    if (pred[destino] == -1)
+    {
+        return CUSTO_INFINITO;
+    }
+
+    for (int atual = destino; atual != origem; atual = pred[atual])
+    {
+        caminho.push_back(atual);
+    }
+    caminho.push_back(origem);
+    reverse(caminho.begin(), caminho.end());
+
+    return dist[destino];
+}
@@ -0,0 +1,101 @@
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include "matriz.h"
+#include "grafo_csr.h"
+#include "paralelo.h"
+#include "custo.h"
+#include "heap_radix.h"
+#include <vector>
+#include <limits>
+
+using namespace std;
+
+// Caminhos mínimos de todos os pares via Dijkstra a partir de cada origem.
+// Para grafos esparsos custa O(n·m log n), contra Θ(n³) do Floyd-Warshall.
+// Os custos são inteiros não negativos, então cada busca usa um heap radix.
+// As origens são divididas entre as threads, cada uma com seu próprio heap;
+// cada origem escreve apenas a própria linha de dist e pred.
+// Convenções iguais às de Grafo::calcularCaminhosMaisCurtos: dist ausente é
+// LimitesCusto<T>::INFINITO, pred[s][s] = s e pred[s][v] = -1 quando v é inalcançável.
+template <typename T>
+void dijkstraTodosPares(const GrafoCSR &grafo, MatrizDensa<T> &dist, MatrizDensa<T> &pred,
+                        int num_threads = obterNumThreads());
+
+// Distâncias apenas entre os terminais (por exemplo, extremidades de serviços e
+// depósito): dist_terminais[a][b] é a distância de terminais[a] a terminais[b].
+// Cada busca para assim que todos os terminais forem alcançados.
+void dijkstraTerminais(const GrafoCSR &grafo, const vector<int> &terminais, MatrizDensa<Custo> &dist_terminais,
+                       int num_threads = obterNumThreads());
+
+// Caminho mínimo de um único par (busca interrompida ao alcançar o destino).
+// Retorna a distância (CUSTO_INFINITO se não houver caminho) e preenche caminho.
+Custo dijkstraCaminho(const GrafoCSR &grafo, int origem, int destino, vector<int> &caminho);
+
+// Vértices em ordem não decrescente de distância a partir de uma origem, sob
+// demanda: visitar(v, distancia) é chamada para cada vértice rotulado e a
+// busca para quando ela retorna false. A área de trabalho é reaproveitada entre
+// buscas e só os vértices alcançados são reinicializados, então uma busca que
+// para cedo custa proporcionalmente à vizinhança explorada, não ao grafo.
+class BuscaIncremental
+{
+private:
+    const GrafoCSR &grafo;
+    vector<uint64_t> dist_provisoria;
+    vector<int> alcancados;
+    HeapRadix heap;
+
+    static constexpr uint64_t NAO_ALCANCADO = numeric_limits<uint64_t>::max();
+
+public:
+    explicit BuscaIncremental(const GrafoCSR &grafo)
+        : grafo(grafo), dist_provisoria(grafo.num_vertices + 1, NAO_ALCANCADO)
+    {
+    }
+
+    template <typename Visitar>
+    void percorrer(int origem, Visitar &&visitar)
+    {
+        // Desfaz só o que a busca anterior tocou
+        for (int v : alcancados)
+        {
+            dist_provisoria[v] = NAO_ALCANCADO;
+        }
+        alcancados.clear();
+
+        dist_provisoria[origem] = 0;
+        alcancados.push_back(origem);
+        heap.limpar();
+        heap.inserir(0, origem);
+
+        while (!heap.vazio())
+        {
+            auto [d, u] = heap.extrairMinimo();
+            if (d > dist_provisoria[u])
+            {
+                continue;
+            }
+            if (d >= static_cast<uint64_t>(CUSTO_INFINITO) || !visitar(u, static_cast<Custo>(d)))
+            {
+                return;
+            }
+
+            for (int e = grafo.inicio[u]; e < grafo.inicio[u + 1]; e++)
+            {
+                int v = grafo.destinos[e];
+                uint64_t nova_dist = d + static_cast<uint64_t>(grafo.pesos[e]);
+                if (nova_dist < dist_provisoria[v])
+                {
+                    if (dist_provisoria[v] == NAO_ALCANCADO)
+                    {
+                        alcancados.push_back(v);
+                    }
+                    dist_provisoria[v] = nova_dist;
+                    heap.inserir(nova_dist, v);
+                }
+            }
+        }
+    }
+};
+
+#endif // DIJKSTRA_H
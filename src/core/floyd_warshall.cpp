@@ -0,0 +1,318 @@
+#include "floyd_warshall.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FW_X86 1
+#include <immintrin.h>
+#endif
+
+// Assinatura comum dos kernels: relaxa o bloco [i0,i1) x [j0,j1) usando os
+// vértices intermediários [k0,k1). j0 é múltiplo de TAMANHO_BLOCO_FW e j1 é
+// múltiplo de uma linha de cache, de modo que as linhas podem ser lidas com
+// cargas alinhadas. Distâncias e predecessores têm a mesma largura, então a
+// máscara de melhoria serve diretamente para as duas misturas.
+template <typename T>
+using FuncaoRelaxarBloco = void (*)(MatrizDensa<T> &dist, MatrizDensa<T> &pred,
+                                    int i0, int i1, int j0, int j1, int k0, int k1);
+
+// Versão portátil, sem desvios no laço interno (o compilador pode vetorizá-la).
+// Como toda distância é <= INFINITO = max/2, a soma nunca transborda e um
+// candidato que passa por um par sem caminho nunca é menor que o valor atual.
+template <typename T>
+static void relaxarBlocoEscalar(MatrizDensa<T> &dist, MatrizDensa<T> &pred,
+                                int i0, int i1, int j0, int j1, int k0, int k1)
+{
+    for (int k = k0; k < k1; k++)
+    {
+        const T *__restrict dist_k = dist[k];
+        const T *__restrict pred_k = pred[k];
+        for (int i = i0; i < i1; i++)
+        {
+            T dist_ik = dist[i][k];
+            // A linha k não muda durante a iteração k; linhas sem caminho até k não melhoram
+            if (i == k || dist_ik >= LimitesCusto<T>::INFINITO)
+                continue;
+
+            T *__restrict dist_i = dist[i];
+            T *__restrict pred_i = pred[i];
+            for (int j = j0; j < j1; j++)
+            {
+                T candidato = static_cast<T>(dist_ik + dist_k[j]);
+                bool melhora = candidato < dist_i[j];
+                dist_i[j] = melhora ? candidato : dist_i[j];
+                pred_i[j] = melhora ? pred_k[j] : pred_i[j];
+            }
+        }
+    }
+}
+
+#ifdef FW_X86
+
+// SSE2 faz parte da base x86-64: 4 (int32) ou 8 (int16) faixas, mistura por máscara
+template <typename T>
+static void relaxarBlocoSSE2(MatrizDensa<T> &dist, MatrizDensa<T> &pred,
+                             int i0, int i1, int j0, int j1, int k0, int k1)
+{
+    constexpr int FAIXAS = 16 / sizeof(T);
+    for (int k = k0; k < k1; k++)
+    {
+        const T *dist_k = dist[k];
+        const T *pred_k = pred[k];
+        for (int i = i0; i < i1; i++)
+        {
+            T dist_ik = dist[i][k];
+            if (i == k || dist_ik >= LimitesCusto<T>::INFINITO)
+                continue;
+
+            T *dist_i = dist[i];
+            T *pred_i = pred[i];
+            const __m128i v_ik = sizeof(T) == 4 ? _mm_set1_epi32(dist_ik) : _mm_set1_epi16(dist_ik);
+            for (int j = j0; j < j1; j += FAIXAS)
+            {
+                __m128i linha_k = _mm_load_si128(reinterpret_cast<const __m128i *>(dist_k + j));
+                __m128i atual = _mm_load_si128(reinterpret_cast<const __m128i *>(dist_i + j));
+                __m128i candidato, mascara;
+                if constexpr (sizeof(T) == 4)
+                {
+                    candidato = _mm_add_epi32(v_ik, linha_k);
+                    mascara = _mm_cmplt_epi32(candidato, atual);
+                }
+                else
+                {
+                    candidato = _mm_add_epi16(v_ik, linha_k);
+                    mascara = _mm_cmplt_epi16(candidato, atual);
+                }
+                _mm_store_si128(reinterpret_cast<__m128i *>(dist_i + j),
+                                _mm_or_si128(_mm_and_si128(mascara, candidato), _mm_andnot_si128(mascara, atual)));
+
+                __m128i pred_atual = _mm_load_si128(reinterpret_cast<const __m128i *>(pred_i + j));
+                __m128i pred_novo = _mm_load_si128(reinterpret_cast<const __m128i *>(pred_k + j));
+                _mm_store_si128(reinterpret_cast<__m128i *>(pred_i + j),
+                                _mm_or_si128(_mm_and_si128(mascara, pred_novo), _mm_andnot_si128(mascara, pred_atual)));
+            }
+        }
+    }
+}
+
+template <typename T>
+__attribute__((target("avx2"))) static void relaxarBlocoAVX2(MatrizDensa<T> &dist, MatrizDensa<T> &pred,
+                                                              int i0, int i1, int j0, int j1, int k0, int k1)
+{
+    constexpr int FAIXAS = 32 / sizeof(T);
+    for (int k = k0; k < k1; k++)
+    {
+        const T *dist_k = dist[k];
+        const T *pred_k = pred[k];
+        for (int i = i0; i < i1; i++)
+        {
+            T dist_ik = dist[i][k];
+            if (i == k || dist_ik >= LimitesCusto<T>::INFINITO)
+                continue;
+
+            T *dist_i = dist[i];
+            T *pred_i = pred[i];
+            const __m256i v_ik = sizeof(T) == 4 ? _mm256_set1_epi32(dist_ik) : _mm256_set1_epi16(dist_ik);
+            for (int j = j0; j < j1; j += FAIXAS)
+            {
+                __m256i linha_k = _mm256_load_si256(reinterpret_cast<const __m256i *>(dist_k + j));
+                __m256i atual = _mm256_load_si256(reinterpret_cast<const __m256i *>(dist_i + j));
+                __m256i candidato, mascara;
+                if constexpr (sizeof(T) == 4)
+                {
+                    candidato = _mm256_add_epi32(v_ik, linha_k);
+                    mascara = _mm256_cmpgt_epi32(atual, candidato);
+                }
+                else
+                {
+                    candidato = _mm256_add_epi16(v_ik, linha_k);
+                    mascara = _mm256_cmpgt_epi16(atual, candidato);
+                }
+                _mm256_store_si256(reinterpret_cast<__m256i *>(dist_i + j), _mm256_blendv_epi8(atual, candidato, mascara));
+
+                __m256i pred_atual = _mm256_load_si256(reinterpret_cast<const __m256i *>(pred_i + j));
+                __m256i pred_novo = _mm256_load_si256(reinterpret_cast<const __m256i *>(pred_k + j));
+                _mm256_store_si256(reinterpret_cast<__m256i *>(pred_i + j), _mm256_blendv_epi8(pred_atual, pred_novo, mascara));
+            }
+        }
+    }
+}
+
+// Um vetor de 512 bits é exatamente uma linha de cache: 16 (int32) ou 32 (int16) faixas.
+// As operações de 16 bits exigem AVX-512BW.
+template <typename T>
+__attribute__((target("avx512f,avx512bw"))) static void relaxarBlocoAVX512(MatrizDensa<T> &dist, MatrizDensa<T> &pred,
+                                                                           int i0, int i1, int j0, int j1, int k0, int k1)
+{
+    constexpr int FAIXAS = 64 / sizeof(T);
+    for (int k = k0; k < k1; k++)
+    {
+        const T *dist_k = dist[k];
+        const T *pred_k = pred[k];
+        for (int i = i0; i < i1; i++)
+        {
+            T dist_ik = dist[i][k];
+            if (i == k || dist_ik >= LimitesCusto<T>::INFINITO)
+                continue;
+
+            T *dist_i = dist[i];
+            T *pred_i = pred[i];
+            const __m512i v_ik = sizeof(T) == 4 ? _mm512_set1_epi32(dist_ik) : _mm512_set1_epi16(dist_ik);
+            for (int j = j0; j < j1; j += FAIXAS)
+            {
+                __m512i linha_k = _mm512_load_si512(dist_k + j);
+                __m512i atual = _mm512_load_si512(dist_i + j);
+                __m512i pred_atual = _mm512_load_si512(pred_i + j);
+                __m512i pred_novo = _mm512_load_si512(pred_k + j);
+                if constexpr (sizeof(T) == 4)
+                {
+                    __m512i candidato = _mm512_add_epi32(v_ik, linha_k);
+                    __mmask16 mascara = _mm512_cmplt_epi32_mask(candidato, atual);
+                    _mm512_store_si512(dist_i + j, _mm512_mask_mov_epi32(atual, mascara, candidato));
+                    _mm512_store_si512(pred_i + j, _mm512_mask_mov_epi32(pred_atual, mascara, pred_novo));
+                }
+                else
+                {
+                    __m512i candidato = _mm512_add_epi16(v_ik, linha_k);
+                    __mmask32 mascara = _mm512_cmplt_epi16_mask(candidato, atual);
+                    _mm512_store_si512(dist_i + j, _mm512_mask_mov_epi16(atual, mascara, candidato));
+                    _mm512_store_si512(pred_i + j, _mm512_mask_mov_epi16(pred_atual, mascara, pred_novo));
+                }
+            }
+        }
+    }
+}
+
+#endif // FW_X86
+
+KernelFloydWarshall kernelFloydWarshallDisponivel()
+{
+#ifdef FW_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    {
+        return KernelFloydWarshall::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return KernelFloydWarshall::AVX2;
+    }
+    return KernelFloydWarshall::SSE2;
+#else
+    return KernelFloydWarshall::ESCALAR;
+#endif
+}
+
+string nomeKernelFloydWarshall(KernelFloydWarshall kernel)
+{
+    switch (kernel)
+    {
+    case KernelFloydWarshall::ESCALAR:
+        return "escalar";
+    case KernelFloydWarshall::SSE2:
+        return "SSE2";
+    case KernelFloydWarshall::AVX2:
+        return "AVX2";
+    case KernelFloydWarshall::AVX512:
+        return "AVX-512";
+    default:
+        return "automático";
+    }
+}
+
+template <typename T>
+static FuncaoRelaxarBloco<T> selecionarKernel(KernelFloydWarshall kernel)
+{
+    if (kernel == KernelFloydWarshall::AUTOMATICO)
+    {
+        kernel = kernelFloydWarshallDisponivel();
+    }
+
+#ifdef FW_X86
+    switch (kernel)
+    {
+    case KernelFloydWarshall::AVX512:
+        return relaxarBlocoAVX512<T>;
+    case KernelFloydWarshall::AVX2:
+        return relaxarBlocoAVX2<T>;
+    case KernelFloydWarshall::SSE2:
+        return relaxarBlocoSSE2<T>;
+    default:
+        break;
+    }
+#endif
+    return relaxarBlocoEscalar<T>;
+}
+
+template <typename T>
+void floydWarshallBloqueado(MatrizDensa<T> &dist, MatrizDensa<T> &pred, int num_threads,
+                            KernelFloydWarshall kernel)
+{
+    FuncaoRelaxarBloco<T> relaxar = selecionarKernel<T>(kernel);
+
+    const int B = TAMANHO_BLOCO_FW;
+    const int n = dist.getLinhas();
+
+    // As colunas de preenchimento (infinito) também são varridas: assim toda
+    // linha de bloco tem largura múltipla do vetor e dispensa laço de resto
+    const int largura = static_cast<int>(dist.getPasso());
+    const int blocos_linha = (n + B - 1) / B;
+    const int blocos_coluna = (largura + B - 1) / B;
+
+    // Não adianta ter mais threads do que blocos em uma linha de blocos
+    num_threads = max(1, min(num_threads, blocos_linha - 1));
+    BarreiraThreads barreira(num_threads);
+
+    // Cada fase é dividida entre as threads em rodízio fixo; dentro de uma fase
+    // os blocos são independentes, então o resultado não depende do número de threads
+    executarEmThreads(num_threads, [&](int id)
+    {
+        for (int kb = 0; kb < blocos_linha; kb++)
+        {
+            const int k0 = kb * B;
+            const int k1 = min(k0 + B, n);
+            const int kc1 = min(k0 + B, largura);
+
+            // Fase 1: bloco diagonal
+            if (id == 0)
+            {
+                relaxar(dist, pred, k0, k1, k0, kc1, k0, k1);
+            }
+            barreira.aguardar();
+
+            // Fase 2: blocos da linha e da coluna do bloco diagonal
+            int item = 0;
+            for (int jb = 0; jb < blocos_coluna; jb++)
+            {
+                if (jb == kb)
+                    continue;
+                if (item++ % num_threads == id)
+                    relaxar(dist, pred, k0, k1, jb * B, min(jb * B + B, largura), k0, k1);
+            }
+            for (int ib = 0; ib < blocos_linha; ib++)
+            {
+                if (ib == kb)
+                    continue;
+                if (item++ % num_threads == id)
+                    relaxar(dist, pred, ib * B, min(ib * B + B, n), k0, kc1, k0, k1);
+            }
+            barreira.aguardar();
+
+            // Fase 3: blocos restantes, distribuídos por linha de blocos
+            item = 0;
+            for (int ib = 0; ib < blocos_linha; ib++)
+            {
+                if (ib == kb || item++ % num_threads != id)
+                    continue;
+                for (int jb = 0; jb < blocos_coluna; jb++)
+                {
+                    if (jb == kb)
+                        continue;
+                    relaxar(dist, pred, ib * B, min(ib * B + B, n), jb * B, min(jb * B + B, largura), k0, k1);
+                }
+            }
+            barreira.aguardar();
+        }
+    });
+}
+
+template void floydWarshallBloqueado<int32_t>(MatrizDensa<int32_t> &, MatrizDensa<int32_t> &, int, KernelFloydWarshall);
+template void floydWarshallBloqueado<int16_t>(MatrizDensa<int16_t> &, MatrizDensa<int16_t> &, int, KernelFloydWarshall);
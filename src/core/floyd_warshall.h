@@ -0,0 +1,43 @@
+#ifndef FLOYD_WARSHALL_H
+#define FLOYD_WARSHALL_H
+
+#include "matriz.h"
+#include "paralelo.h"
+#include "custo.h"
+#include <string>
+
+using namespace std;
+
+// Conjuntos de instruções disponíveis para o kernel min-plus
+enum class KernelFloydWarshall
+{
+    AUTOMATICO, // Escolhe em tempo de execução o melhor suportado pela CPU
+    ESCALAR,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+// Tamanho (em vértices) do lado de um bloco; um bloco de distâncias mais o de
+// predecessores cabe com folga na L2 e a linha k do bloco permanece na L1
+constexpr int TAMANHO_BLOCO_FW = 64;
+
+// Floyd-Warshall bloqueado (3 fases por bloco diagonal) sobre matrizes já
+// inicializadas com os pesos diretos. Distâncias ausentes devem valer
+// LimitesCusto<T>::INFINITO. T é o tipo das distâncias e dos predecessores
+// (int32_t, ou int16_t quando distâncias e número de vértices cabem em 16 bits,
+// o que dobra o número de faixas por vetor). Os blocos de cada fase são
+// processados em paralelo por num_threads threads; o resultado não depende
+// do número de threads nem do kernel.
+template <typename T>
+void floydWarshallBloqueado(MatrizDensa<T> &dist, MatrizDensa<T> &pred,
+                            int num_threads = obterNumThreads(),
+                            KernelFloydWarshall kernel = KernelFloydWarshall::AUTOMATICO);
+
+// Kernel efetivamente usado quando o modo é AUTOMATICO
+KernelFloydWarshall kernelFloydWarshallDisponivel();
+
+// Nome legível de um kernel (para relatórios)
+string nomeKernelFloydWarshall(KernelFloydWarshall kernel);
+
+#endif // FLOYD_WARSHALL_H
@@ -1,314 +1,366 @@
 #include "grafo.h"
+#include "floyd_warshall.h"
+#include "dijkstra.h"
+#include "centralidade.h"
+#include "registro.h"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <queue>
 #include <cmath>
 
-Grafo::Grafo() : num_vertices(0), valor_otimo(-1), num_veiculos(-1), capacidade(0), deposito(0) {}
+MotorCaminhos Grafo::motor_caminhos = MotorCaminhos::AUTOMATICO;
+LarguraDistancias Grafo::largura_distancias = LarguraDistancias::AUTOMATICA;
+ModoIntermediacao Grafo::modo_intermediacao = ModoIntermediacao::EXATA;
+ParametrosAmostragem Grafo::parametros_amostragem;
+bool Grafo::cache_caminhos_ativo = true;
+string Grafo::diretorio_cache_caminhos = "cache_caminhos";
 
-double Grafo::calcularDensidade()
+Grafo::Grafo() : num_vertices(0), valor_otimo(-1), num_veiculos(-1), capacidade(0), deposito(0),
+                 distancias_16_bits(false), modo_distancias(ModoDistancias::COMPLETA) {}
+
+// Intermediação exata (Brandes) ou amostrada, conforme o modo configurado.
+// A amostragem só compensa quando exige menos pares do que há origens no
+// grafo; caso contrário o cálculo exato é mais barato e não tem erro
+vector<double> Grafo::intermediacaoConfigurada(ResultadoAmostragem &amostra) const
 {
-    int num_arestas = arestas.size();
-    int num_arcos = arcos.size();
+    amostra.amostras_previstas = 0;
+    amostra.amostras_realizadas = 0;
+    amostra.epsilon_obtido = 0.0;
 
-    double densidade = (2.0 * num_arestas + num_arcos) / (num_vertices * (num_vertices - 1));
+    if (modo_intermediacao == ModoIntermediacao::AMOSTRADA &&
+        amostrasNecessarias(csr.num_vertices, parametros_amostragem.epsilon, parametros_amostragem.delta) < csr.num_vertices)
+    {
+        amostra = intermediacaoAmostrada(csr, parametros_amostragem);
+        return move(amostra.intermediacao);
+    }
 
-    return densidade;
+    return intermediacaoBrandes(csr);
 }
 
-map<int, int> Grafo::calcularGraus()
+// Calcula todas as métricas da Etapa 1 a partir das matrizes já calculadas em
+// lerArquivoDados, sem refazer caminhos mínimos: os graus vêm de uma passada
+// pelas ligações, caminho médio e diâmetro de uma única varredura dos pares
+// (s,t) e a intermediação do algoritmo de Brandes sobre a adjacência compacta
+ResumoMetricas Grafo::calcularMetricas() const
 {
-    map<int, int> graus;
+    ResumoMetricas resumo;
+    resumo.densidade = (2.0 * arestas.size() + arcos.size()) / (num_vertices * (num_vertices - 1.0));
 
-    // Inicializar todos os vértices com grau 0
-    for (int v : vertices)
+    // Graus em vetor indexado pelo vértice
+    vector<int> graus(num_vertices + 1, 0);
+    for (const auto &[u, v] : arestas)
     {
-        graus[v] = 0;
-    }
-
-    // Contar arestas (cada aresta adiciona 1 ao grau de ambos os vértices)
-    for (const auto &aresta : arestas)
-    {
-        int u = aresta.first;
-        int v = aresta.second;
         graus[u]++;
         graus[v]++;
     }
-
-    // Contar arcos (arco de saída adiciona 1 ao grau de saída, arco de entrada adiciona 1 ao grau de entrada)
-    for (const auto &arco : arcos)
+    for (const auto &[u, v] : arcos)
     {
-        int u = arco.first;
-        int v = arco.second;
         graus[u]++;
         graus[v]++;
     }
 
-    return graus;
-}
-
-int Grafo::grausMinimo()
-{
-    map<int, int> graus = calcularGraus();
-
-    int grau_minimo = numeric_limits<int>::max();
-    for (const auto &[v, grau] : graus)
-    {
-        grau_minimo = min(grau_minimo, grau);
-    }
-    return grau_minimo;
-}
-
-int Grafo::grausMaximo()
-{
-    map<int, int> graus = calcularGraus();
-
-    int grau_maximo = 0;
-    for (const auto &[v, grau] : graus)
+    resumo.grau_minimo = numeric_limits<int>::max();
+    resumo.grau_maximo = 0;
+    for (int v : vertices)
     {
-        grau_maximo = max(grau_maximo, grau);
+        resumo.grau_minimo = min(resumo.grau_minimo, graus[v]);
+        resumo.grau_maximo = max(resumo.grau_maximo, graus[v]);
     }
-    return grau_maximo;
-}
-
-// Calcular caminhos mínimos de todas as origens para todos os destinos
-pair<vector<vector<double>>, vector<vector<int>>> Grafo::floydWarshall()
-{
-    // Inicializa matriz de distância com infinito
-    vector<vector<double>> dist(num_vertices + 1, vector<double>(num_vertices + 1, numeric_limits<double>::infinity()));
-
-    // Inicializa matriz de predecessores com -1
-    vector<vector<int>> pred(num_vertices + 1, vector<int>(num_vertices + 1, -1));
 
-    // A distância de um vértice para ele mesmo é 0
-    for (int i = 1; i <= num_vertices; i++)
+    VisaoMatriz<Custo> dist = tabela(matriz_dist, mapa_dist);
+    VisaoMatriz<int16_t> dist16 = tabela(matriz_dist16, mapa_dist16);
+    if (dist.vazia() && dist16.vazia())
     {
-        dist[i][i] = 0;
+        throw runtime_error("calcularMetricas exige as matrizes completas de caminhos (ModoDistancias::COMPLETA)");
     }
 
-    // Define as distâncias iniciais com base na lista de adjacência
-    for (const auto &[u, vizinhos] : adj)
-    {
-        for (const auto &[v, peso] : vizinhos)
-        {
-            dist[u][v] = peso;
-            pred[u][v] = u;
-        }
-    }
+    // Varredura única dos pares: soma (exata, em inteiros) e maior distância
+    long long soma_distancias = 0;
+    long long count = 0;
+    Custo diametro = 0;
 
-    // Algoritmo de Floyd-Warshall
-    for (int k = 1; k <= num_vertices; k++)
+    auto varrer = [&](const auto &dist)
     {
-        for (int i = 1; i <= num_vertices; i++)
+        using T = typename remove_const<typename remove_reference<decltype(dist[0][0])>::type>::type;
+        for (int s : vertices)
         {
-            for (int j = 1; j <= num_vertices; j++)
+            const T *dist_s = dist[s];
+            for (int t : vertices)
             {
-                if (dist[i][k] != numeric_limits<double>::infinity() &&
-                    dist[k][j] != numeric_limits<double>::infinity() &&
-                    dist[i][k] + dist[k][j] < dist[i][j])
+                // Ignorar o próprio vértice e caminhos inexistentes
+                if (s == t || dist_s[t] >= LimitesCusto<T>::INFINITO)
                 {
-                    dist[i][j] = dist[i][k] + dist[k][j];
-                    pred[i][j] = pred[k][j];
+                    continue;
                 }
+
+                soma_distancias += dist_s[t];
+                count++;
+                diametro = max<Custo>(diametro, dist_s[t]);
             }
         }
+    };
+
+    if (distancias_16_bits)
+    {
+        varrer(dist16);
     }
+    else
+    {
+        varrer(dist);
+    }
+
+    resumo.caminho_medio = (count > 0) ? (static_cast<double>(soma_distancias) / count) : 0.0;
+    resumo.diametro = diametro;
 
-    return {dist, pred};
+    // Intermediação por Brandes (dividindo o crédito entre caminhos empatados) ou amostrada
+    ResultadoAmostragem amostra;
+    vector<double> intermediacao = intermediacaoConfigurada(amostra);
+    resumo.amostras_intermediacao = amostra.amostras_realizadas;
+    resumo.amostras_previstas = amostra.amostras_previstas;
+    resumo.erro_intermediacao = amostra.epsilon_obtido;
+    for (int v : vertices)
+    {
+        resumo.intermediacao[v] = intermediacao[v];
+    }
+
+    return resumo;
 }
 
-// Reconstruir o caminho mais curto entre dois vértices
-vector<int> Grafo::reconstruirCaminho(const vector<vector<int>> &pred, int origem, int destino)
+// Escolhe o motor de caminhos mínimos: Dijkstra por origem custa ~n·m·log n
+// e Floyd-Warshall ~n³, mas com constante muito menor graças à vetorização.
+// Os divisores abaixo foram calibrados nas instâncias DI-NEARP: o kernel de
+// 32 bits é ~2x mais rápido que o de double usado antes (divisor 28), e o de
+// 16 bits ganha mais ~1,5x por processar o dobro de faixas por vetor
+MotorCaminhos Grafo::escolherMotorCaminhos(size_t bytes_distancia) const
 {
-    vector<int> caminho;
-
-    // Se não existe caminho
-    if (pred[origem][destino] == -1)
+    if (motor_caminhos != MotorCaminhos::AUTOMATICO)
     {
-        return caminho;
+        return motor_caminhos;
     }
 
-    // Reconstruir o caminho do destino até a origem
-    int atual = destino;
-    while (atual != origem)
+    size_t num_ligacoes = csr.numLigacoes();
+
+    double n = num_vertices;
+    double custo_dijkstra = n * (num_ligacoes + n) * log2(max(2.0, n));
+    double custo_floyd = n * n * n / (bytes_distancia <= 2 ? 84.0 : 56.0);
+
+    return custo_dijkstra < custo_floyd ? MotorCaminhos::DIJKSTRA : MotorCaminhos::FLOYD_WARSHALL;
+}
+
+// As matrizes de 16 bits exigem que toda distância finita fique abaixo do
+// sentinela e que os vértices caibam como predecessores. Um caminho mínimo é
+// simples: tem no máximo n - 1 ligações e não repete ligação, então
+// min((n - 1) · maior custo, soma dos custos) limita qualquer distância
+bool Grafo::cabeEm16Bits() const
+{
+    long long maior = 0;
+    long long soma = 0;
+    for (Custo peso : csr.pesos)
     {
-        caminho.push_back(atual);
-        atual = pred[origem][atual];
+        maior = max<long long>(maior, peso);
+        soma += peso;
     }
-    caminho.push_back(origem);
 
-    // Inverter o caminho para ficar da origem para o destino
-    reverse(caminho.begin(), caminho.end());
+    long long limite = min(static_cast<long long>(max(num_vertices - 1, 0)) * maior, soma);
+    return limite < LimitesCusto<int16_t>::INFINITO && num_vertices < numeric_limits<int16_t>::max();
+}
 
-    return caminho;
+bool Grafo::deveUsar16Bits() const
+{
+    return largura_distancias != LarguraDistancias::BITS_32 && cabeEm16Bits();
 }
 
-// Cálculo da intermediação (betweenness centrality)
-map<int, double> Grafo::calcularIntermediacao()
+template <typename T>
+void Grafo::calcularTabelaCaminhos(MatrizDensa<T> &dist, MatrizDensa<T> &pred)
 {
-    map<int, double> intermediacao;
+    dist = MatrizDensa<T>(num_vertices + 1, num_vertices + 1, LimitesCusto<T>::INFINITO);
+    pred = MatrizDensa<T>(num_vertices + 1, num_vertices + 1, -1);
 
-    // Inicializa a intermediação de todos os vértices com 0
-    for (int v : vertices)
+    if (escolherMotorCaminhos(sizeof(T)) == MotorCaminhos::DIJKSTRA)
     {
-        intermediacao[v] = 0.0;
+        REGISTRO_DEPURACAO("Motor: Dijkstra a partir de cada origem, " << obterNumThreads() << " thread(s)");
+        dijkstraTodosPares(csr, dist, pred);
+        return;
     }
 
-    // Obter caminhos mais curtos entre todos os pares de vértices
-    auto [dist, pred] = floydWarshall();
+    // A distância de um vértice para ele mesmo é 0
+    for (int i = 1; i <= num_vertices; i++)
+    {
+        dist[i][i] = 0;
+        pred[i][i] = i;  // Predecessor de um nó para ele mesmo é o próprio nó
+    }
 
-    // Para cada par de vértices (s,t)
-    for (int s : vertices)
+    // Define as distâncias iniciais com base na lista de adjacência
+    // (com ligações paralelas, vale a de menor custo)
+    for (int u = 1; u <= num_vertices; u++)
     {
-        for (int t : vertices)
+        for (int e = csr.inicio[u]; e < csr.inicio[u + 1]; e++)
         {
-            // Ignorar quando s = t ou quando não há caminho
-            if (s == t || dist[s][t] == numeric_limits<double>::infinity())
-            {
-                continue;
-            }
-
-            // Contar vértices intermediários no caminho mais curto de s a t
-            vector<int> caminho = reconstruirCaminho(pred, s, t);
-
-            // Incrementar a intermediação de cada vértice no caminho (exceto s e t)
-            for (size_t i = 1; i < caminho.size() - 1; i++)
+            int v = csr.destinos[e];
+            if (csr.pesos[e] < dist[u][v])
             {
-                intermediacao[caminho[i]] += 1.0;
+                dist[u][v] = csr.pesos[e];
+                pred[u][v] = u;
             }
         }
     }
 
-    return intermediacao;
+    // Algoritmo de Floyd-Warshall (versão bloqueada e vetorizada)
+    REGISTRO_DEPURACAO("Motor: Floyd-Warshall, kernel min-plus " << nomeKernelFloydWarshall(kernelFloydWarshallDisponivel())
+                       << ", blocos de " << TAMANHO_BLOCO_FW << " vértices, " << obterNumThreads() << " thread(s)");
+    floydWarshallBloqueado(dist, pred);
 }
 
-// Calcular o caminho médio do grafo
-double Grafo::calcularCaminhoMedio()
+// Método para calcular as matrizes de distâncias e predecessores de todos os pares
+void Grafo::calcularCaminhosMaisCurtos()
 {
-    // Obter matriz de distâncias usando Floyd-Warshall
-    auto [dist, pred] = floydWarshall();
+    REGISTRO_DEPURACAO("Iniciando cálculo de caminhos mais curtos...");
 
-    double soma_distancias = 0.0;
-    int count = 0;
+    limparTabelasCaminhos();
 
-    // Somar as distâncias entre todos os pares de vértices
-    for (int i = 1; i <= num_vertices; i++)
+    distancias_16_bits = deveUsar16Bits();
+    if (distancias_16_bits)
     {
-        for (int j = 1; j <= num_vertices; j++)
-        {
-            // Ignorar o próprio vértice e caminhos inexistentes
-            if (i != j && dist[i][j] != numeric_limits<double>::infinity())
-            {
-                soma_distancias += dist[i][j];
-                count++;
-            }
-        }
+        REGISTRO_DEPURACAO("Distâncias em 16 bits");
+        calcularTabelaCaminhos(matriz_dist16, matriz_pred16);
+    }
+    else
+    {
+        REGISTRO_DEPURACAO("Distâncias em 32 bits");
+        calcularTabelaCaminhos(matriz_dist, matriz_pred);
     }
 
-    // Calcular a média
-    double caminho_medio = (count > 0) ? (soma_distancias / count) : 0.0;
+    REGISTRO_DEPURACAO("Cálculo de caminhos mais curtos concluído!");
+}
+
+void Grafo::limparTabelasCaminhos()
+{
+    matriz_dist.limpar();
+    matriz_pred.limpar();
+    matriz_dist16.limpar();
+    matriz_pred16.limpar();
+    mapeamento_caminhos.reset();
+    mapa_dist = VisaoMatriz<Custo>();
+    mapa_pred = VisaoMatriz<Custo>();
+    mapa_dist16 = VisaoMatriz<int16_t>();
+    mapa_pred16 = VisaoMatriz<int16_t>();
+}
+
+// Mapeia as matrizes completas gravadas por uma execução anterior (mesmo grafo,
+// mesma largura). As tabelas em uso passam a ser as visões sobre o arquivo
+bool Grafo::carregarCaminhosDoCache(uint64_t hash)
+{
+    bool usar_16_bits = deveUsar16Bits();
+    bool carregado = usar_16_bits
+                         ? carregarCacheCaminhos(diretorio_cache_caminhos, hash, num_vertices + 1,
+                                                 mapa_dist16, mapa_pred16, mapeamento_caminhos)
+                         : carregarCacheCaminhos(diretorio_cache_caminhos, hash, num_vertices + 1,
+                                                 mapa_dist, mapa_pred, mapeamento_caminhos);
+    if (carregado)
+    {
+        distancias_16_bits = usar_16_bits;
+        REGISTRO_DEPURACAO("Caminhos mínimos carregados do cache (" << (usar_16_bits ? 16 : 32) << " bits)");
+    }
+    return carregado;
+}
 
-    return caminho_medio;
+void Grafo::salvarCaminhosNoCache(uint64_t hash) const
+{
+    bool salvo = distancias_16_bits
+                     ? salvarCacheCaminhos(diretorio_cache_caminhos, hash, matriz_dist16, matriz_pred16)
+                     : salvarCacheCaminhos(diretorio_cache_caminhos, hash, matriz_dist, matriz_pred);
+    if (!salvo)
+    {
+        REGISTRO_AVISO("Aviso: não foi possível gravar o cache de caminhos em " << diretorio_cache_caminhos);
+    }
 }
 
-// Calcular o diâmetro do grafo
-double Grafo::calcularDiametro()
+// Calcula apenas as distâncias entre terminais: o depósito e as extremidades
+// (origem/destino) de todos os serviços, que são os únicos pares consultados
+// pela construção e pela otimização de rotas
+void Grafo::calcularDistanciasTerminais()
 {
-    // Obter matriz de distâncias usando Floyd-Warshall
-    auto [dist, pred] = floydWarshall();
+    REGISTRO_DEPURACAO("Iniciando cálculo de distâncias entre terminais...");
 
-    double diametro = 0.0;
+    indice_terminal.assign(num_vertices + 1, -1);
+    vector<int> terminais;
 
-    // Encontrar a maior distância finita entre quaisquer dois vértices
-    for (int i = 1; i <= num_vertices; i++)
+    auto adicionarTerminal = [&](int v)
     {
-        for (int j = 1; j <= num_vertices; j++)
+        if (v >= 1 && v <= num_vertices && indice_terminal[v] == -1)
         {
-            // Ignorar o próprio vértice e caminhos inexistentes
-            if (i != j && dist[i][j] != numeric_limits<double>::infinity())
-            {
-                diametro = max(diametro, dist[i][j]);
-            }
+            indice_terminal[v] = terminais.size();
+            terminais.push_back(v);
         }
+    };
+
+    adicionarTerminal(deposito);
+    for (const auto &servico : servicos)
+    {
+        adicionarTerminal(servico.origem);
+        adicionarTerminal(servico.destino);
     }
 
-    return diametro;
+    dijkstraTerminais(csr, terminais, dist_terminais);
+
+    REGISTRO_DEPURACAO("Terminais: " << terminais.size() << " de " << num_vertices << " vértices, "
+                       << obterNumThreads() << " thread(s)");
+    REGISTRO_DEPURACAO("Cálculo de distâncias entre terminais concluído!");
 }
 
-// Método para calcular caminhos mais curtos usando o resultado de Floyd-Warshall
-void Grafo::calcularCaminhosMaisCurtos()
+// Método para obter a distância entre dois vértices
+Custo Grafo::getDistancia(int origem, int destino) const
 {
-    cout << "Iniciando cálculo de caminhos mais curtos..." << endl;
-    
-    // Inicializar as matrizes com o tamanho correto
-    matriz_dist.clear();
-    matriz_pred.clear();
-    
-    matriz_dist.resize(num_vertices + 1, vector<double>(num_vertices + 1, numeric_limits<double>::infinity()));
-    matriz_pred.resize(num_vertices + 1, vector<int>(num_vertices + 1, -1));
-    
-    // A distância de um vértice para ele mesmo é 0
-    for (int i = 1; i <= num_vertices; i++)
+    // Verificação de limites
+    if (origem <= 0 || origem > num_vertices || destino <= 0 || destino > num_vertices)
     {
-        matriz_dist[i][i] = 0;
-        matriz_pred[i][i] = i;  // Predecessor de um nó para ele mesmo é o próprio nó
+        REGISTRO_ERRO("Erro em getDistancia: Índices fora dos limites - origem=" << origem << ", destino=" << destino << ", num_vertices=" << num_vertices);
+        return CUSTO_INFINITO;
     }
     
-    // Define as distâncias iniciais com base na lista de adjacência
-    for (const auto &[u, vizinhos] : adj)
+    if (modo_distancias == ModoDistancias::TERMINAIS)
     {
-        for (const auto &[v, peso] : vizinhos)
+        int a = indice_terminal[origem];
+        int b = indice_terminal[destino];
+        if (a >= 0 && b >= 0)
         {
-            matriz_dist[u][v] = peso;
-            matriz_pred[u][v] = u;
+            return dist_terminais[a][b];
         }
-    }
-    
-    // Algoritmo de Floyd-Warshall
-    for (int k = 1; k <= num_vertices; k++)
-    {
-        cout << "Processando vértice intermediário " << k << "/" << num_vertices << endl;
-        for (int i = 1; i <= num_vertices; i++)
+
+        // Par fora da tabela: busca pontual, só da distância e interrompida no
+        // destino. Caminho lento (ver ModoDistancias::TERMINAIS)
+        Custo distancia = CUSTO_INFINITO;
+        BuscaIncremental busca(csr);
+        busca.percorrer(origem, [&](int v, Custo d)
         {
-            for (int j = 1; j <= num_vertices; j++)
+            if (v != destino)
             {
-                if (matriz_dist[i][k] != numeric_limits<double>::infinity() &&
-                    matriz_dist[k][j] != numeric_limits<double>::infinity() &&
-                    matriz_dist[i][k] + matriz_dist[k][j] < matriz_dist[i][j])
-                {
-                    matriz_dist[i][j] = matriz_dist[i][k] + matriz_dist[k][j];
-                    matriz_pred[i][j] = matriz_pred[k][j];
-                }
+                return true;
             }
-        }
+            distancia = d;
+            return false;
+        });
+        return distancia;
     }
     
-    cout << "Cálculo de caminhos mais curtos concluído!" << endl;
-}
-// Método para obter a distância entre dois vértices
-double Grafo::getDistancia(int origem, int destino) const
-{
-    // Verificação de limites
-    if (origem <= 0 || origem > num_vertices || destino <= 0 || destino > num_vertices)
+    if (distancias_16_bits)
     {
-        cerr << "Erro em getDistancia: Índices fora dos limites - origem=" << origem << ", destino=" << destino << ", num_vertices=" << num_vertices << endl;
-        return numeric_limits<double>::infinity();
+        int16_t distancia = tabela(matriz_dist16, mapa_dist16)[origem][destino];
+        return distancia >= LimitesCusto<int16_t>::INFINITO ? CUSTO_INFINITO : distancia;
     }
-    
+
     // Verifica se a matriz está inicializada corretamente
-    if (matriz_dist.empty() || matriz_dist.size() <= (size_t)origem || 
-        matriz_dist[origem].empty() || matriz_dist[origem].size() <= (size_t)destino)
+    VisaoMatriz<Custo> dist = tabela(matriz_dist, mapa_dist);
+    if (dist.vazia() || dist.getLinhas() <= origem || dist.getColunas() <= destino)
     {
-        cerr << "Erro em getDistancia: Matriz de distâncias não inicializada corretamente!" << endl;
-        cerr << "matriz_dist.size()=" << matriz_dist.size() << ", origem=" << origem << endl;
-        if (!matriz_dist.empty() && matriz_dist.size() > (size_t)origem) {
-            cerr << "matriz_dist[origem].size()=" << matriz_dist[origem].size() << ", destino=" << destino << endl;
-        }
-        return numeric_limits<double>::infinity();
+        REGISTRO_ERRO("Erro em getDistancia: Matriz de distâncias não inicializada corretamente!");
+        REGISTRO_ERRO("matriz_dist: " << dist.getLinhas() << "x" << dist.getColunas()
+                      << ", origem=" << origem << ", destino=" << destino);
+        return CUSTO_INFINITO;
     }
     
-    return matriz_dist[origem][destino];
+    return dist[origem][destino];
 }
 
 // Método para obter o caminho entre dois vértices
@@ -321,28 +373,45 @@ vector<int> Grafo::obterCaminho(int origem, int destino) const
     // Verificação de limites
     if (origem <= 0 || origem > num_vertices || destino <= 0 || destino > num_vertices)
     {
-        cerr << "Erro em obterCaminho: Índices fora dos limites - origem=" << origem << ", destino=" << destino << ", num_vertices=" << num_vertices << endl;
+        REGISTRO_ERRO("Erro em obterCaminho: Índices fora dos limites - origem=" << origem << ", destino=" << destino << ", num_vertices=" << num_vertices);
         return vector<int>();
     }
     
-    // Verifica se a matriz está inicializada corretamente
-    if (matriz_pred.empty() || matriz_pred.size() <= (size_t)origem || 
-        matriz_pred[origem].empty() || matriz_pred[origem].size() <= (size_t)destino)
+    // No modo TERMINAIS os caminhos são reconstruídos sob demanda
+    if (modo_distancias == ModoDistancias::TERMINAIS)
     {
-        cerr << "Erro em obterCaminho: Matriz de predecessores não inicializada corretamente!" << endl;
-        cerr << "matriz_pred.size()=" << matriz_pred.size() << ", origem=" << origem << endl;
-        if (!matriz_pred.empty() && matriz_pred.size() > (size_t)origem) {
-            cerr << "matriz_pred[origem].size()=" << matriz_pred[origem].size() << ", destino=" << destino << endl;
+        vector<int> caminho;
+        if (dijkstraCaminho(csr, origem, destino, caminho) == CUSTO_INFINITO)
+        {
+            REGISTRO_AVISO("Aviso: Não existe caminho de " << origem << " para " << destino);
         }
+        return caminho;
+    }
+    
+    // Predecessor de v no caminho a partir de origem, qualquer que seja a largura
+    VisaoMatriz<Custo> pred = tabela(matriz_pred, mapa_pred);
+    VisaoMatriz<int16_t> pred16 = tabela(matriz_pred16, mapa_pred16);
+    auto predecessor = [&](int v) -> int
+    {
+        return distancias_16_bits ? pred16[origem][v] : pred[origem][v];
+    };
+
+    // Verifica se a matriz está inicializada corretamente
+    if (!distancias_16_bits &&
+        (pred.vazia() || pred.getLinhas() <= origem || pred.getColunas() <= destino))
+    {
+        REGISTRO_ERRO("Erro em obterCaminho: Matriz de predecessores não inicializada corretamente!");
+        REGISTRO_ERRO("matriz_pred: " << pred.getLinhas() << "x" << pred.getColunas()
+                      << ", origem=" << origem << ", destino=" << destino);
         return vector<int>();
     }
     
     vector<int> caminho;
     
     // Se não existe caminho
-    if (matriz_pred[origem][destino] == -1)
+    if (predecessor(destino) == -1)
     {
-        cerr << "Aviso: Não existe caminho de " << origem << " para " << destino << endl;
+        REGISTRO_AVISO("Aviso: Não existe caminho de " << origem << " para " << destino);
         return caminho;
     }
     
@@ -351,12 +420,12 @@ vector<int> Grafo::obterCaminho(int origem, int destino) const
     while (atual != origem)
     {
         caminho.push_back(atual);
-        atual = matriz_pred[origem][atual];
+        atual = predecessor(atual);
         
         // Evitar loop infinito se houver inconsistência
         if (static_cast<int>(caminho.size()) > num_vertices)
         {
-            cerr << "Erro em obterCaminho: Loop detectado na reconstrução do caminho de " << origem << " para " << destino << endl;
+            REGISTRO_ERRO("Erro em obterCaminho: Loop detectado na reconstrução do caminho de " << origem << " para " << destino);
             return vector<int>();
         }
     }
@@ -368,7 +437,7 @@ vector<int> Grafo::obterCaminho(int origem, int destino) const
     return caminho;
 }
 
-void Grafo::lerArquivoDados(const string &nome_arquivo)
+void Grafo::lerArquivoDados(const string &nome_arquivo, ModoDistancias modo)
 {
     // Limpar dados anteriores
     vertices.clear();
@@ -377,42 +446,65 @@ void Grafo::lerArquivoDados(const string &nome_arquivo)
     arestas_requeridas.clear();
     arcos.clear();
     arcos_requeridos.clear();
-    adj.clear();
+    csr = GrafoCSR();
     servicos.clear();
-    matriz_dist.clear();
-    matriz_pred.clear();
+    limparTabelasCaminhos();
+    distancias_16_bits = false;
+    dist_terminais.limpar();
+    indice_terminal.clear();
     
     // Usar o LeitorArquivo para ler os dados
     DadosGrafo dados = LeitorArquivo::lerArquivoDados(nome_arquivo);
     
-    // Carregar os dados na classe
-    carregarDados(dados);
+    // Carregar os dados na classe (sem cópia: as estruturas são movidas)
+    carregarDados(move(dados));
     
+    // Matrizes completas já gravadas para este grafo atendem os dois modos
+    // (no modo TERMINAIS, mapear é mais barato que rodar os Dijkstras)
+    uint64_t hash = cache_caminhos_ativo ? hashConteudoGrafo(csr) : 0;
+    if (cache_caminhos_ativo && carregarCaminhosDoCache(hash))
+    {
+        modo_distancias = ModoDistancias::COMPLETA;
+        return;
+    }
+
     // Calcular caminhos mais curtos
-    calcularCaminhosMaisCurtos();
+    modo_distancias = modo;
+    if (modo == ModoDistancias::TERMINAIS)
+    {
+        calcularDistanciasTerminais();
+    }
+    else
+    {
+        calcularCaminhosMaisCurtos();
+        if (cache_caminhos_ativo)
+        {
+            salvarCaminhosNoCache(hash);
+        }
+    }
 }
 
-void Grafo::carregarDados(const DadosGrafo &dados)
+void Grafo::carregarDados(DadosGrafo &&dados)
 {
-    // Copiar estrutura básica
+    // Estrutura básica
     num_vertices = dados.num_vertices;
-    vertices = dados.vertices;
-    arestas = dados.arestas;
-    arcos = dados.arcos;
-    adj = dados.adj;
+    vertices = move(dados.vertices);
+    arestas = move(dados.arestas);
+    arcos = move(dados.arcos);
+    csr = move(dados.adjacencia);
     
-    // Copiar elementos requeridos
-    vertices_requeridos = dados.vertices_requeridos;
-    arestas_requeridas = dados.arestas_requeridas;
-    arcos_requeridos = dados.arcos_requeridos;
+    // Elementos requeridos
+    vertices_requeridos = move(dados.vertices_requeridos);
+    arestas_requeridas = move(dados.arestas_requeridas);
+    arcos_requeridos = move(dados.arcos_requeridos);
     
-    // Copiar metadados
-    nome = dados.nome;
+    // Metadados
+    nome = move(dados.nome);
     valor_otimo = dados.valor_otimo;
     num_veiculos = dados.num_veiculos;
     capacidade = dados.capacidade;
     deposito = dados.deposito;
     
-    // Copiar serviços
-    servicos = dados.servicos;
+    // Serviços
+    servicos = move(dados.servicos);
 }
\ No newline at end of file
@@ -8,11 +8,63 @@
 #include <string>
 #include <limits>
 #include <algorithm>
+#include <memory>
+#include "matriz.h"
+#include "grafo_csr.h"
+#include "custo.h"
+#include "centralidade.h"
 #include "../io/estruturas_grafo.h"
 #include "../io/leitor_arquivo.h"
+#include "../io/cache_caminhos.h"
 
 using namespace std;
 
+// Algoritmo usado para os caminhos mínimos de todos os pares
+enum class MotorCaminhos
+{
+    AUTOMATICO,     // Escolhe pelo tamanho e pela densidade do grafo
+    FLOYD_WARSHALL, // Θ(n³), bloqueado e vetorizado
+    DIJKSTRA        // Dijkstra a partir de cada origem, O(n·m log n)
+};
+
+// Quais distâncias lerArquivoDados pré-calcula. No modo TERMINAIS, getDistancia
+// de um par fora da tabela faz um Dijkstra pontual (O(m log n) por chamada, em
+// vez de O(1)): nenhuma etapa consulta esses pares, o recurso é só para depuração.
+enum class ModoDistancias
+{
+    COMPLETA, // Matrizes n x n de distâncias e predecessores
+    TERMINAIS // Tabela k x k só entre extremidades de serviços e depósito; caminhos sob demanda
+};
+
+// Largura das matrizes de distâncias e predecessores do modo COMPLETA
+enum class LarguraDistancias
+{
+    AUTOMATICA, // 16 bits quando distâncias e vértices cabem, senão 32
+    BITS_32,
+    BITS_16     // Só é usada se couber; caso contrário cai para 32 bits
+};
+
+// Como calcularIntermediacao e calcularMetricas obtêm a intermediação
+enum class ModoIntermediacao
+{
+    EXATA,    // Brandes sobre todas as origens
+    AMOSTRADA // Amostragem de pares com erro epsilon e confiança 1 - delta
+};
+
+// Métricas da Etapa 1 obtidas em uma única varredura das matrizes de caminhos
+struct ResumoMetricas
+{
+    double densidade;
+    int grau_minimo;
+    int grau_maximo;
+    double caminho_medio;
+    Custo diametro;
+    map<int, double> intermediacao;
+    long long amostras_intermediacao; // 0 quando a intermediação é exata
+    long long amostras_previstas;     // Pares necessários para garantir o epsilon pedido
+    double erro_intermediacao;        // Erro garantido na escala normalizada (dividida por n(n-1))
+};
+
 class Grafo
 {
 private:
@@ -21,7 +73,7 @@ private:
     set<int> vertices;
     vector<pair<int, int>> arestas;          // Arestas
     vector<pair<int, int>> arcos;            // Arestas direcionadas
-    map<int, vector<pair<int, double>>> adj; // Lista de adjacência com pesos
+    GrafoCSR csr;                            // Adjacência compacta com pesos (montada pelo LeitorArquivo)
 
     // obrigatórios
     set<int> vertices_requeridos;
@@ -35,11 +87,36 @@ private:
     int capacidade;           // Capacidade dos veículos
     int deposito;             // Nó depósito
 
-    vector<vector<double>> matriz_dist; // Matriz de distâncias
-    vector<vector<int>> matriz_pred;    // Matriz de predecessores
+    // Matrizes de distâncias e predecessores (contíguas, alinhadas); só um dos
+    // pares é preenchido, conforme a largura escolhida em calcularCaminhosMaisCurtos
+    MatrizDensa<Custo> matriz_dist;
+    MatrizDensa<Custo> matriz_pred;
+    MatrizDensa<int16_t> matriz_dist16;
+    MatrizDensa<int16_t> matriz_pred16;
+    bool distancias_16_bits;
+
+    // Tabelas lidas do cache: visões somente leitura sobre o arquivo mapeado,
+    // usadas no lugar das matrizes acima enquanto mapeamento_caminhos existir
+    shared_ptr<ArquivoMapeado> mapeamento_caminhos;
+    VisaoMatriz<Custo> mapa_dist;
+    VisaoMatriz<Custo> mapa_pred;
+    VisaoMatriz<int16_t> mapa_dist16;
+    VisaoMatriz<int16_t> mapa_pred16;
+
+    // Modo TERMINAIS: distâncias só entre extremidades de serviços e o depósito
+    ModoDistancias modo_distancias;
+    vector<int> indice_terminal;         // Vértice -> linha em dist_terminais (-1 se não é terminal)
+    MatrizDensa<Custo> dist_terminais;   // Distâncias entre terminais (k x k)
 
     string nome;
 
+    static MotorCaminhos motor_caminhos; // Motor usado por calcularCaminhosMaisCurtos
+    static LarguraDistancias largura_distancias;
+    static ModoIntermediacao modo_intermediacao;
+    static ParametrosAmostragem parametros_amostragem;
+    static bool cache_caminhos_ativo;          // Reaproveitar/gravar matrizes em disco
+    static string diretorio_cache_caminhos;
+
 public:
     Grafo();
 
@@ -47,6 +124,7 @@ public:
     string getNomeArquivo() const { return nome; }
     int getNumEdges() const { return arestas.size(); }
     int getNumArcs() const { return arcos.size(); }
+    const GrafoCSR &getAdjacencia() const { return csr; }
     int getNumRequiredVertices() const { return vertices_requeridos.size(); }
     int getNumRequiredEdges() const { return arestas_requeridas.size(); }
     int getNumRequiredArcs() const { return arcos_requeridos.size(); }
@@ -57,37 +135,66 @@ public:
     int getDeposito() const { return deposito; }
     const vector<Servico> &getServicos() const { return servicos; }
 
-    double calcularDensidade();
-    map<int, int> calcularGraus();
-    int grausMinimo();
-    int grausMaximo();
-
-    // Calcular caminhos mínimos de todas as origens para todos os destinos
-    pair<vector<vector<double>>, vector<vector<int>>> floydWarshall();
-
-    // Reconstruir o caminho mais curto entre dois vértices
-    vector<int> reconstruirCaminho(const vector<vector<int>> &pred, int origem, int destino);
-
-    // Cálculo da intermediação (betweenness centrality)
-    map<int, double> calcularIntermediacao();
-
-    // Calcular o caminho médio do grafo
-    double calcularCaminhoMedio();
-
-    // Calcular o diâmetro do grafo
-    double calcularDiametro();
+    // Todas as métricas de uma vez, reaproveitando as matrizes calculadas na leitura
+    ResumoMetricas calcularMetricas() const;
 
     // Novos métodos
     void calcularCaminhosMaisCurtos();
-    double getDistancia(int origem, int destino) const;
+    void calcularDistanciasTerminais();
+    ModoDistancias getModoDistancias() const { return modo_distancias; }
+    int getNumTerminais() const { return dist_terminais.getLinhas(); }
+    MotorCaminhos escolherMotorCaminhos(size_t bytes_distancia = sizeof(Custo)) const;
+    static void definirMotorCaminhos(MotorCaminhos motor) { motor_caminhos = motor; }
+    static MotorCaminhos obterMotorCaminhos() { return motor_caminhos; }
+    static void definirLarguraDistancias(LarguraDistancias largura) { largura_distancias = largura; }
+    static LarguraDistancias obterLarguraDistancias() { return largura_distancias; }
+    bool cabeEm16Bits() const;
+    bool usaDistancias16Bits() const { return distancias_16_bits; }
+    static void definirIntermediacaoExata() { modo_intermediacao = ModoIntermediacao::EXATA; }
+    static void definirIntermediacaoAmostrada(const ParametrosAmostragem &parametros)
+    {
+        modo_intermediacao = ModoIntermediacao::AMOSTRADA;
+        parametros_amostragem = parametros;
+    }
+    static ModoIntermediacao obterModoIntermediacao() { return modo_intermediacao; }
+    static const ParametrosAmostragem &obterParametrosAmostragem() { return parametros_amostragem; }
+    static void definirCacheCaminhos(bool ativo) { cache_caminhos_ativo = ativo; }
+    static void definirDiretorioCacheCaminhos(const string &diretorio) { diretorio_cache_caminhos = diretorio; }
+    static bool obterCacheCaminhos() { return cache_caminhos_ativo; }
+    static const string &obterDiretorioCacheCaminhos() { return diretorio_cache_caminhos; }
+    Custo getDistancia(int origem, int destino) const;
     vector<int> obterCaminho(int origem, int destino) const;
 
     // Método atualizado para usar o LeitorArquivo
-    void lerArquivoDados(const string &nome_arquivo);
+    void lerArquivoDados(const string &nome_arquivo, ModoDistancias modo = ModoDistancias::COMPLETA);
 
 private:
     // Método auxiliar para carregar dados do LeitorArquivo
-    void carregarDados(const DadosGrafo &dados);
+    void carregarDados(DadosGrafo &&dados);
+
+    // Intermediação no modo configurado; amostra.amostras_realizadas = 0 se exata
+    vector<double> intermediacaoConfigurada(ResultadoAmostragem &amostra) const;
+
+    // Inicializa com as ligações diretas e resolve pelo motor escolhido
+    template <typename T>
+    void calcularTabelaCaminhos(MatrizDensa<T> &dist, MatrizDensa<T> &pred);
+
+    // Tabela em uso: a mapeada do cache, se houver, senão a calculada
+    template <typename T>
+    VisaoMatriz<T> tabela(const MatrizDensa<T> &calculada, const VisaoMatriz<T> &mapeada) const
+    {
+        return mapeamento_caminhos ? mapeada : VisaoMatriz<T>(calculada);
+    }
+
+    // Descarta as tabelas calculadas e as mapeadas
+    void limparTabelasCaminhos();
+
+    // Largura que calcularCaminhosMaisCurtos usará para este grafo
+    bool deveUsar16Bits() const;
+
+    // Cache em disco das matrizes completas (ver io/cache_caminhos.h)
+    bool carregarCaminhosDoCache(uint64_t hash);
+    void salvarCaminhosNoCache(uint64_t hash) const;
 };
 
 #endif // GRAFO_H
\ No newline at end of file
@@ -0,0 +1,116 @@
+#ifndef GRAFO_CSR_H
+#define GRAFO_CSR_H
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include "custo.h"
+
+using namespace std;
+
+// Ligação dirigida u -> v com seu custo de travessia
+struct LigacaoCSR
+{
+    int origem;
+    int destino;
+    Custo peso;
+};
+
+// Lista de adjacência compacta (compressed sparse row): os vizinhos de u estão
+// em destinos/pesos nas posições [inicio[u], inicio[u + 1])
+struct GrafoCSR
+{
+    int num_vertices;
+    vector<int> inicio;    // Tamanho num_vertices + 2 (vértices numerados de 1 a n)
+    vector<int> destinos;
+    vector<Custo> pesos;
+
+    GrafoCSR() : num_vertices(0) {}
+
+    int grauSaida(int u) const { return inicio[u + 1] - inicio[u]; }
+    size_t numLigacoes() const { return destinos.size(); }
+
+    // Monta a estrutura a partir das ligações (u -> v). A ordenação por contagem
+    // é estável: os vizinhos de cada vértice ficam na ordem em que foram lidos.
+    // Custos devem ser não negativos e sua soma menor que CUSTO_INFINITO
+    static GrafoCSR construir(int num_vertices, const vector<LigacaoCSR> &ligacoes)
+    {
+        GrafoCSR csr;
+        csr.num_vertices = num_vertices;
+        csr.inicio.assign(num_vertices + 2, 0);
+
+        long long soma_pesos = 0;
+        for (const auto &ligacao : ligacoes)
+        {
+            if (ligacao.origem < 1 || ligacao.origem > num_vertices ||
+                ligacao.destino < 1 || ligacao.destino > num_vertices)
+            {
+                throw runtime_error("Ligação (" + to_string(ligacao.origem) + "," + to_string(ligacao.destino) +
+                                    ") fora do intervalo de vértices 1.." + to_string(num_vertices));
+            }
+            if (ligacao.peso < 0)
+            {
+                throw runtime_error("Ligação (" + to_string(ligacao.origem) + "," + to_string(ligacao.destino) +
+                                    ") com custo negativo");
+            }
+            csr.inicio[ligacao.origem + 1]++;
+            soma_pesos += ligacao.peso;
+        }
+
+        // Com a soma abaixo do sentinela, nenhum caminho simples (nem a soma de
+        // duas distâncias) transborda o tipo Custo
+        if (soma_pesos >= CUSTO_INFINITO)
+        {
+            throw runtime_error("Soma dos custos (" + to_string(soma_pesos) + ") não cabe no tipo Custo");
+        }
+        for (int u = 1; u <= num_vertices + 1; u++)
+        {
+            csr.inicio[u] += csr.inicio[u - 1];
+        }
+
+        csr.destinos.resize(ligacoes.size());
+        csr.pesos.resize(ligacoes.size());
+        vector<int> pos(csr.inicio.begin(), csr.inicio.end() - 1);
+        for (const auto &ligacao : ligacoes)
+        {
+            int p = pos[ligacao.origem]++;
+            csr.destinos[p] = ligacao.destino;
+            csr.pesos[p] = ligacao.peso;
+        }
+
+        return csr;
+    }
+
+    // Grafo com todas as ligações invertidas (vizinhos de entrada de cada vértice)
+    GrafoCSR transposto() const
+    {
+        GrafoCSR reverso;
+        reverso.num_vertices = num_vertices;
+        reverso.inicio.assign(num_vertices + 2, 0);
+        for (int v : destinos)
+        {
+            reverso.inicio[v + 1]++;
+        }
+        for (int u = 1; u <= num_vertices + 1; u++)
+        {
+            reverso.inicio[u] += reverso.inicio[u - 1];
+        }
+
+        reverso.destinos.resize(destinos.size());
+        reverso.pesos.resize(pesos.size());
+        vector<int> pos(reverso.inicio.begin(), reverso.inicio.end() - 1);
+        for (int u = 1; u <= num_vertices; u++)
+        {
+            for (int e = inicio[u]; e < inicio[u + 1]; e++)
+            {
+                int p = pos[destinos[e]]++;
+                reverso.destinos[p] = u;
+                reverso.pesos[p] = pesos[e];
+            }
+        }
+
+        return reverso;
+    }
+};
+
+#endif // GRAFO_CSR_H
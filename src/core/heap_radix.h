@@ -0,0 +1,74 @@
+#ifndef HEAP_RADIX_H
+#define HEAP_RADIX_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+using namespace std;
+
+// Heap radix monotônico para chaves inteiras: como Dijkstra só extrai chaves
+// não decrescentes, cada chave k fica no balde dado pelo bit mais alto em que
+// difere da última chave extraída. Inserção O(1) e extração O(log C) amortizada.
+class HeapRadix
+{
+private:
+    static constexpr int NUM_BALDES = 65;
+    vector<pair<uint64_t, int>> baldes[NUM_BALDES];
+    uint64_t ultima;
+    size_t tamanho;
+
+    int balde(uint64_t chave) const
+    {
+        return chave == ultima ? 0 : 64 - __builtin_clzll(chave ^ ultima);
+    }
+
+public:
+    HeapRadix() : ultima(0), tamanho(0) {}
+
+    bool vazio() const { return tamanho == 0; }
+
+    void limpar()
+    {
+        for (auto &b : baldes)
+        {
+            b.clear();
+        }
+        ultima = 0;
+        tamanho = 0;
+    }
+
+    void inserir(uint64_t chave, int vertice)
+    {
+        baldes[balde(chave)].push_back({chave, vertice});
+        tamanho++;
+    }
+
+    pair<uint64_t, int> extrairMinimo()
+    {
+        if (baldes[0].empty())
+        {
+            // Redistribui o primeiro balde não vazio a partir do seu menor elemento
+            int i = 1;
+            while (baldes[i].empty())
+            {
+                i++;
+            }
+
+            ultima = min_element(baldes[i].begin(), baldes[i].end())->first;
+            for (const auto &entrada : baldes[i])
+            {
+                baldes[balde(entrada.first)].push_back(entrada);
+            }
+            baldes[i].clear();
+        }
+
+        pair<uint64_t, int> minimo = baldes[0].back();
+        baldes[0].pop_back();
+        tamanho--;
+        return minimo;
+    }
+};
+
+#endif // HEAP_RADIX_H
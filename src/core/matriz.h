@@ -0,0 +1,220 @@
+#ifndef MATRIZ_H
+#define MATRIZ_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <algorithm>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+// Alinhamento de uma linha de cache
+constexpr size_t ALINHAMENTO_CACHE = 64;
+
+// Tamanho de uma página enorme (transparent huge page) no Linux x86-64
+constexpr size_t TAMANHO_PAGINA_ENORME = 2 * 1024 * 1024;
+
+// Buffer contíguo alinhado a 64 bytes, opcionalmente apoiado em páginas enormes
+template <typename T>
+class BufferAlinhado
+{
+private:
+    T *dados;
+    size_t tamanho;
+
+    void alocar(size_t n, bool paginas_enormes)
+    {
+        tamanho = n;
+        dados = nullptr;
+        if (n == 0)
+        {
+            return;
+        }
+
+        size_t bytes = n * sizeof(T);
+        size_t alinhamento = ALINHAMENTO_CACHE;
+
+        // Buffers grandes são alinhados à página enorme para que o kernel possa usar THP
+        if (paginas_enormes && bytes >= TAMANHO_PAGINA_ENORME)
+        {
+            alinhamento = TAMANHO_PAGINA_ENORME;
+        }
+
+        // aligned_alloc exige tamanho múltiplo do alinhamento
+        bytes = (bytes + alinhamento - 1) / alinhamento * alinhamento;
+        dados = static_cast<T *>(aligned_alloc(alinhamento, bytes));
+        if (dados == nullptr)
+        {
+            throw bad_alloc();
+        }
+
+#ifdef MADV_HUGEPAGE
+        if (alinhamento == TAMANHO_PAGINA_ENORME)
+        {
+            madvise(dados, bytes, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+public:
+    BufferAlinhado() : dados(nullptr), tamanho(0) {}
+
+    explicit BufferAlinhado(size_t n, bool paginas_enormes = true)
+    {
+        alocar(n, paginas_enormes);
+    }
+
+    BufferAlinhado(const BufferAlinhado &outro)
+    {
+        alocar(outro.tamanho, true);
+        if (tamanho > 0)
+        {
+            memcpy(dados, outro.dados, tamanho * sizeof(T));
+        }
+    }
+
+    BufferAlinhado(BufferAlinhado &&outro) noexcept : dados(outro.dados), tamanho(outro.tamanho)
+    {
+        outro.dados = nullptr;
+        outro.tamanho = 0;
+    }
+
+    BufferAlinhado &operator=(BufferAlinhado outro) noexcept
+    {
+        swap(dados, outro.dados);
+        swap(tamanho, outro.tamanho);
+        return *this;
+    }
+
+    ~BufferAlinhado()
+    {
+        free(dados);
+    }
+
+    T *data() { return dados; }
+    const T *data() const { return dados; }
+    size_t size() const { return tamanho; }
+    bool empty() const { return tamanho == 0; }
+};
+
+// Matriz densa armazenada linha a linha em um único buffer alinhado.
+// Cada linha começa em um limite de 64 bytes (o passo é arredondado para cima),
+// o que permite varrer linhas com acessos sequenciais e cargas vetoriais alinhadas.
+template <typename T>
+class MatrizDensa
+{
+private:
+    int linhas;
+    int colunas;
+    size_t passo; // Número de elementos entre o início de duas linhas consecutivas
+    BufferAlinhado<T> buffer;
+
+public:
+    MatrizDensa() : linhas(0), colunas(0), passo(0) {}
+
+    MatrizDensa(int num_linhas, int num_colunas, T valor_inicial)
+        : linhas(num_linhas), colunas(num_colunas)
+    {
+        passo = passoPara(colunas);
+        buffer = BufferAlinhado<T>(passo * linhas);
+        preencher(valor_inicial);
+    }
+
+    MatrizDensa(const MatrizDensa &outra) = default;
+
+    MatrizDensa(MatrizDensa &&outra) noexcept
+        : linhas(outra.linhas), colunas(outra.colunas), passo(outra.passo), buffer(move(outra.buffer))
+    {
+        outra.limpar();
+    }
+
+    MatrizDensa &operator=(MatrizDensa outra) noexcept
+    {
+        swap(linhas, outra.linhas);
+        swap(colunas, outra.colunas);
+        swap(passo, outra.passo);
+        swap(buffer, outra.buffer);
+        return *this;
+    }
+
+    // Passo (em elementos) de uma linha com num_colunas colunas
+    static size_t passoPara(int num_colunas)
+    {
+        const size_t por_linha_cache = ALINHAMENTO_CACHE / sizeof(T);
+        return (static_cast<size_t>(num_colunas) + por_linha_cache - 1) / por_linha_cache * por_linha_cache;
+    }
+
+    int getLinhas() const { return linhas; }
+    int getColunas() const { return colunas; }
+    size_t getPasso() const { return passo; }
+    bool vazia() const { return buffer.empty(); }
+
+    // Acesso no estilo m[i][j]
+    T *operator[](int i) { return buffer.data() + static_cast<size_t>(i) * passo; }
+    const T *operator[](int i) const { return buffer.data() + static_cast<size_t>(i) * passo; }
+
+    T *data() { return buffer.data(); }
+    const T *data() const { return buffer.data(); }
+
+    // Número de elementos armazenados (linhas x passo)
+    size_t tamanho() const { return passo * linhas; }
+
+    void preencher(T valor)
+    {
+        fill(buffer.data(), buffer.data() + buffer.size(), valor);
+    }
+
+    void limpar()
+    {
+        linhas = 0;
+        colunas = 0;
+        passo = 0;
+        buffer = BufferAlinhado<T>();
+    }
+};
+
+// Visão somente leitura com o layout de MatrizDensa, sobre uma matriz ou sobre
+// memória externa (por exemplo, um arquivo mapeado somente leitura). Não possui
+// os dados: quem a criou deve mantê-los vivos enquanto a visão for usada.
+template <typename T>
+class VisaoMatriz
+{
+private:
+    int linhas;
+    int colunas;
+    size_t passo;
+    const T *dados;
+
+public:
+    VisaoMatriz() : linhas(0), colunas(0), passo(0), dados(nullptr) {}
+
+    // dados_externos: linhas de MatrizDensa<T>::passoPara(num_colunas) elementos,
+    // início alinhado a 64 bytes
+    VisaoMatriz(const T *dados_externos, int num_linhas, int num_colunas)
+        : linhas(num_linhas), colunas(num_colunas), passo(MatrizDensa<T>::passoPara(num_colunas)),
+          dados(dados_externos)
+    {
+    }
+
+    VisaoMatriz(const MatrizDensa<T> &matriz)
+        : linhas(matriz.getLinhas()), colunas(matriz.getColunas()), passo(matriz.getPasso()), dados(matriz.data())
+    {
+    }
+
+    int getLinhas() const { return linhas; }
+    int getColunas() const { return colunas; }
+    size_t getPasso() const { return passo; }
+    bool vazia() const { return dados == nullptr; }
+
+    const T *operator[](int i) const { return dados + static_cast<size_t>(i) * passo; }
+    const T *data() const { return dados; }
+    size_t tamanho() const { return passo * linhas; }
+};
+
+#endif // MATRIZ_H
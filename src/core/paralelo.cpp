@@ -0,0 +1,85 @@
+#include "paralelo.h"
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+static atomic<int> num_threads_configurado(0);
+
+int obterNumThreads()
+{
+    int configurado = num_threads_configurado.load();
+    if (configurado > 0)
+    {
+        return configurado;
+    }
+
+    unsigned int nucleos = thread::hardware_concurrency();
+    return nucleos > 0 ? static_cast<int>(nucleos) : 1;
+}
+
+void definirNumThreads(int num_threads)
+{
+    num_threads_configurado = num_threads > 0 ? num_threads : 0;
+}
+
+BarreiraThreads::BarreiraThreads(int num_threads) : total(num_threads), restantes(num_threads), geracao(0) {}
+
+void BarreiraThreads::aguardar()
+{
+    unique_lock<mutex> lock(mtx);
+    int minha_geracao = geracao;
+
+    if (--restantes == 0)
+    {
+        // Última thread a chegar libera as demais e rearma a barreira
+        geracao++;
+        restantes = total;
+        cv.notify_all();
+        return;
+    }
+
+    cv.wait(lock, [&] { return geracao != minha_geracao; });
+}
+
+void executarEmThreads(int num_threads, const function<void(int)> &tarefa)
+{
+    if (num_threads <= 1)
+    {
+        tarefa(0);
+        return;
+    }
+
+    vector<thread> threads;
+    threads.reserve(num_threads - 1);
+    for (int id = 1; id < num_threads; id++)
+    {
+        threads.emplace_back(tarefa, id);
+    }
+
+    tarefa(0);
+
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+}
+
+void paraleloPara(int inicio, int fim, int num_threads, const function<void(int, int)> &tarefa)
+{
+    if (fim <= inicio)
+    {
+        return;
+    }
+
+    atomic<int> proximo(inicio);
+    num_threads = max(1, min(num_threads, fim - inicio));
+
+    executarEmThreads(num_threads, [&](int id)
+    {
+        for (int i = proximo++; i < fim; i = proximo++)
+        {
+            tarefa(i, id);
+        }
+    });
+}
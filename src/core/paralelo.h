@@ -0,0 +1,37 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+// Número de threads usado pelos algoritmos paralelos (0 = todos os núcleos)
+int obterNumThreads();
+void definirNumThreads(int num_threads);
+
+// Barreira reutilizável para sincronizar as fases de um algoritmo
+class BarreiraThreads
+{
+private:
+    mutex mtx;
+    condition_variable cv;
+    int total;
+    int restantes;
+    int geracao;
+
+public:
+    explicit BarreiraThreads(int num_threads);
+    void aguardar();
+};
+
+// Executa tarefa(id_thread) em num_threads threads, sendo a thread chamadora a de id 0
+void executarEmThreads(int num_threads, const function<void(int)> &tarefa);
+
+// Executa tarefa(indice, id_thread) para cada índice em [inicio, fim), com
+// distribuição dinâmica dos índices entre as threads (bom para tarefas de custo desigual).
+// id_thread está em [0, num_threads) e serve para indexar áreas de trabalho por thread.
+void paraleloPara(int inicio, int fim, int num_threads, const function<void(int, int)> &tarefa);
+
+#endif // PARALELO_H
@@ -0,0 +1,242 @@
+#include "registro.h"
+#include <iostream>
+#include <thread>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+atomic<int> nivel_registro_ativo(static_cast<int>(NivelRegistro::INFO));
+
+void definirNivelRegistro(NivelRegistro nivel)
+{
+    nivel_registro_ativo = static_cast<int>(nivel);
+}
+
+NivelRegistro obterNivelRegistro()
+{
+    return static_cast<NivelRegistro>(nivel_registro_ativo.load());
+}
+
+ostringstream &fluxoRegistro()
+{
+    // Cada mensagem começa com a formatação padrão, mesmo que a anterior
+    // tenha usado fixed/setprecision/setw
+    thread_local ostringstream fluxo;
+    fluxo.str(string());
+    fluxo.clear();
+    fluxo.flags(ios_base::dec | ios_base::skipws);
+    fluxo.precision(6);
+    fluxo.width(0);
+    fluxo.fill(' ');
+    return fluxo;
+}
+
+// Buffer circular limitado com vários produtores e um consumidor (Vyukov):
+// cada posição tem um número de sequência que diz se está livre para a volta
+// atual do produtor ou já publicada para o consumidor. Produtores disputam só
+// o contador de escrita (CAS); não há travas.
+class FilaRegistro
+{
+private:
+    static constexpr size_t CAPACIDADE = 4096; // Potência de 2
+
+    struct Entrada
+    {
+        atomic<size_t> sequencia;
+        NivelRegistro nivel;
+        string texto;
+    };
+
+    unique_ptr<Entrada[]> entradas;
+    alignas(64) atomic<size_t> escrita;
+    alignas(64) size_t leitura; // Só o consumidor altera
+
+public:
+    FilaRegistro() : entradas(new Entrada[CAPACIDADE]), escrita(0), leitura(0)
+    {
+        for (size_t i = 0; i < CAPACIDADE; i++)
+        {
+            entradas[i].sequencia.store(i, memory_order_relaxed);
+        }
+    }
+
+    // false se a fila está cheia
+    bool inserir(NivelRegistro nivel, string &texto)
+    {
+        size_t posicao = escrita.load(memory_order_relaxed);
+        while (true)
+        {
+            Entrada &entrada = entradas[posicao & (CAPACIDADE - 1)];
+            size_t sequencia = entrada.sequencia.load(memory_order_acquire);
+            intptr_t diferenca = static_cast<intptr_t>(sequencia) - static_cast<intptr_t>(posicao);
+            if (diferenca == 0)
+            {
+                if (escrita.compare_exchange_weak(posicao, posicao + 1, memory_order_relaxed))
+                {
+                    entrada.nivel = nivel;
+                    entrada.texto.swap(texto);
+                    entrada.sequencia.store(posicao + 1, memory_order_release);
+                    return true;
+                }
+            }
+            else if (diferenca < 0)
+            {
+                return false;
+            }
+            else
+            {
+                posicao = escrita.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    bool retirar(NivelRegistro &nivel, string &texto)
+    {
+        Entrada &entrada = entradas[leitura & (CAPACIDADE - 1)];
+        if (entrada.sequencia.load(memory_order_acquire) != leitura + 1)
+        {
+            return false;
+        }
+        nivel = entrada.nivel;
+        texto.swap(entrada.texto);
+        entrada.texto.clear();
+        entrada.sequencia.store(leitura + CAPACIDADE, memory_order_release);
+        leitura++;
+        return true;
+    }
+
+    // true se a próxima posição do consumidor já foi publicada
+    bool temPublicada() const
+    {
+        return entradas[leitura & (CAPACIDADE - 1)].sequencia.load(memory_order_acquire) == leitura + 1;
+    }
+
+    size_t totalReservado() const { return escrita.load(memory_order_acquire); }
+    size_t totalRetirado() const { return leitura; }
+};
+
+// Thread que escreve as mensagens no console, em lotes, e descarrega os fluxos
+// só quando a fila esvazia. Com a fila vazia ela dorme em uma variável de
+// condição; o produtor só a acorda (e só toca na trava) se ela estiver dormindo.
+class SaidaRegistro
+{
+private:
+    FilaRegistro fila;
+    atomic<size_t> escritas; // Mensagens já escritas e descarregadas
+    atomic<bool> encerrar;
+    atomic<bool> dormindo;   // Consumidor parado (ou prestes a parar) em fila_publicada
+    mutex trava;
+    condition_variable fila_publicada; // Fila deixou de estar vazia, ou encerrar
+    condition_variable lote_escrito;   // escritas avançou
+    thread consumidor;
+
+    void executar()
+    {
+        NivelRegistro nivel;
+        string texto;
+        while (true)
+        {
+            bool escreveu = false;
+            while (fila.retirar(nivel, texto))
+            {
+                ostream &destino = nivel <= NivelRegistro::AVISO ? cerr : cout;
+                destino << texto << '\n';
+                escreveu = true;
+            }
+
+            if (escreveu)
+            {
+                cout.flush();
+                cerr.flush();
+                {
+                    lock_guard<mutex> guarda(trava);
+                    escritas.store(fila.totalRetirado(), memory_order_release);
+                }
+                lote_escrito.notify_all();
+                continue;
+            }
+
+            if (encerrar.load(memory_order_acquire) && fila.totalRetirado() == fila.totalReservado())
+            {
+                return;
+            }
+
+            // Anuncia que vai dormir e confere a fila de novo: junto com a
+            // barreira em publicar, ou o consumidor vê a mensagem ou o produtor
+            // vê dormindo e o acorda (nenhum aviso se perde)
+            unique_lock<mutex> guarda(trava);
+            dormindo.store(true, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            if (fila.temPublicada() || encerrar.load(memory_order_acquire))
+            {
+                dormindo.store(false, memory_order_relaxed);
+                continue;
+            }
+            fila_publicada.wait(guarda, [&] { return !dormindo.load(memory_order_relaxed); });
+        }
+    }
+
+    void acordar()
+    {
+        {
+            lock_guard<mutex> guarda(trava);
+            dormindo.store(false, memory_order_relaxed);
+        }
+        fila_publicada.notify_one();
+    }
+
+public:
+    SaidaRegistro() : escritas(0), encerrar(false), dormindo(false)
+    {
+        consumidor = thread(&SaidaRegistro::executar, this);
+    }
+
+    ~SaidaRegistro()
+    {
+        encerrar = true;
+        acordar();
+        consumidor.join();
+    }
+
+    void publicar(NivelRegistro nivel, string &&mensagem)
+    {
+        // Fila cheia: o produtor espera em vez de descartar mensagens
+        while (!fila.inserir(nivel, mensagem))
+        {
+            this_thread::yield();
+        }
+
+        // Só há o que acordar se o consumidor esvaziou a fila e foi dormir
+        atomic_thread_fence(memory_order_seq_cst);
+        if (dormindo.load(memory_order_relaxed))
+        {
+            acordar();
+        }
+    }
+
+    void descarregar()
+    {
+        size_t alvo = fila.totalReservado();
+        unique_lock<mutex> guarda(trava);
+        lote_escrito.wait(guarda, [&] { return escritas.load(memory_order_acquire) >= alvo; });
+    }
+};
+
+// Criada na primeira mensagem; o destrutor (na saída do programa) escreve o
+// que restar na fila
+static SaidaRegistro &saidaRegistro()
+{
+    static SaidaRegistro saida;
+    return saida;
+}
+
+void registrarMensagem(NivelRegistro nivel, string &&mensagem)
+{
+    saidaRegistro().publicar(nivel, move(mensagem));
+}
+
+void descarregarRegistro()
+{
+    saidaRegistro().descarregar();
+}
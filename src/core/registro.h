@@ -0,0 +1,66 @@
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+// Níveis das mensagens de diagnóstico, do mais ao menos importante
+enum class NivelRegistro
+{
+    ERRO,      // Enviado para cerr
+    AVISO,     // Enviado para cerr
+    INFO,      // Progresso por instância e resumos (padrão)
+    DEPURACAO, // Detalhes por instância: motor, leitura, rotas construídas
+    RASTRO     // Detalhes por rota/iteração; só existe se compilado com NIVEL_REGISTRO_MAXIMO=4
+};
+
+// Nível máximo compilado. Chamadas acima dele somem do binário (a condição é
+// constante), inclusive a formatação dos argumentos.
+#ifndef NIVEL_REGISTRO_MAXIMO
+#define NIVEL_REGISTRO_MAXIMO 3
+#endif
+
+// Nível ativo em tempo de execução (padrão: INFO)
+void definirNivelRegistro(NivelRegistro nivel);
+NivelRegistro obterNivelRegistro();
+
+extern atomic<int> nivel_registro_ativo;
+
+inline bool registroAtivo(NivelRegistro nivel)
+{
+    return static_cast<int>(nivel) <= NIVEL_REGISTRO_MAXIMO &&
+           static_cast<int>(nivel) <= nivel_registro_ativo.load(memory_order_relaxed);
+}
+
+// Enfileira uma linha já formatada. Quem chama só formata e publica em um
+// buffer circular sem travas; uma thread dedicada escreve no console.
+void registrarMensagem(NivelRegistro nivel, string &&mensagem);
+
+// Espera todas as mensagens já enfileiradas serem escritas (e o console
+// descarregado). Usar antes de ler do teclado ou de escrever direto em cout.
+void descarregarRegistro();
+
+// Fluxo de formatação reaproveitado por thread
+ostringstream &fluxoRegistro();
+
+#define REGISTRAR(nivel, expressao)                      \
+    do                                                   \
+    {                                                    \
+        if (registroAtivo(nivel))                        \
+        {                                                \
+            ostringstream &fluxo_registro = fluxoRegistro(); \
+            fluxo_registro << expressao;                 \
+            registrarMensagem(nivel, fluxo_registro.str()); \
+        }                                                \
+    } while (0)
+
+#define REGISTRO_ERRO(expressao) REGISTRAR(NivelRegistro::ERRO, expressao)
+#define REGISTRO_AVISO(expressao) REGISTRAR(NivelRegistro::AVISO, expressao)
+#define REGISTRO_INFO(expressao) REGISTRAR(NivelRegistro::INFO, expressao)
+#define REGISTRO_DEPURACAO(expressao) REGISTRAR(NivelRegistro::DEPURACAO, expressao)
+#define REGISTRO_RASTRO(expressao) REGISTRAR(NivelRegistro::RASTRO, expressao)
+
+#endif // REGISTRO_H
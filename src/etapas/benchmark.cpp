@@ -0,0 +1,162 @@
+#include "benchmark.h"
+#include "../core/paralelo.h"
+#include "../core/floyd_warshall.h"
+#include "../core/registro.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+namespace fs = std::filesystem;
+
+void executarBenchmarkFloydWarshall()
+{
+    REGISTRO_INFO("Iniciando benchmark de escalabilidade do Floyd-Warshall");
+
+    string diretorio_dados = "./dados/";
+    string filtro = "n833"; // Maiores instâncias do conjunto (DI-NEARP-n833)
+
+    if (!fs::exists(diretorio_dados))
+    {
+        REGISTRO_ERRO("Erro: Diretório de dados não encontrado: " << diretorio_dados);
+        return;
+    }
+
+    vector<string> arquivos;
+    for (const auto &entrada : fs::directory_iterator(diretorio_dados))
+    {
+        string nome_arquivo = entrada.path().filename().string();
+        if (entrada.is_regular_file() && entrada.path().extension() == ".dat" &&
+            nome_arquivo.find(filtro) != string::npos)
+        {
+            arquivos.push_back(entrada.path().string());
+        }
+    }
+    sort(arquivos.begin(), arquivos.end());
+
+    if (arquivos.empty())
+    {
+        REGISTRO_ERRO("Nenhuma instância contendo '" << filtro << "' encontrada em: " << diretorio_dados);
+        return;
+    }
+
+    // 1, 2, 4, ... até o número de núcleos disponíveis (incluindo o próprio máximo)
+    int num_threads_original = obterNumThreads();
+    int max_threads = num_threads_original;
+    vector<int> contagens_threads;
+    for (int t = 1; t < max_threads; t *= 2)
+    {
+        contagens_threads.push_back(t);
+    }
+    contagens_threads.push_back(max_threads);
+
+    REGISTRO_INFO("Kernel min-plus: " << nomeKernelFloydWarshall(kernelFloydWarshallDisponivel()));
+    REGISTRO_INFO("Threads avaliadas: até " << max_threads);
+
+    // O benchmark mede o Floyd-Warshall: o motor fica fixo enquanto ele roda,
+    // seja qual for o escolhido no menu ou pela regra automática
+    MotorCaminhos motor_original = Grafo::obterMotorCaminhos();
+    Grafo::definirMotorCaminhos(MotorCaminhos::FLOYD_WARSHALL);
+
+    vector<MedicaoEscalabilidade> todas_medicoes;
+    try
+    {
+        for (const string &arquivo : arquivos)
+        {
+            vector<MedicaoEscalabilidade> medicoes = medirEscalabilidade(arquivo, contagens_threads, 3);
+            todas_medicoes.insert(todas_medicoes.end(), medicoes.begin(), medicoes.end());
+        }
+    }
+    catch (...)
+    {
+        definirNumThreads(num_threads_original);
+        Grafo::definirMotorCaminhos(motor_original);
+        throw;
+    }
+
+    definirNumThreads(num_threads_original);
+    Grafo::definirMotorCaminhos(motor_original);
+
+    // Relatório
+    REGISTRO_INFO("\n=== ESCALABILIDADE DO FLOYD-WARSHALL ===");
+    REGISTRO_INFO(left << setw(22) << "Instância" << right << setw(10) << "Vértices" << setw(9) << "Threads"
+                  << setw(12) << "Tempo (s)" << setw(12) << "Aceleração" << setw(12) << "Eficiência");
+    for (const auto &m : todas_medicoes)
+    {
+        REGISTRO_INFO(left << setw(22) << m.instancia << right << setw(10) << m.num_vertices << setw(9) << m.num_threads
+                      << fixed << setprecision(4) << setw(12) << m.tempo_segundos
+                      << setprecision(2) << setw(12) << m.aceleracao << setw(12) << m.eficiencia);
+    }
+
+    exportarEscalabilidadeCSV(todas_medicoes, "resultados_escalabilidade_fw.csv");
+
+    REGISTRO_INFO("\n=== BENCHMARK CONCLUÍDO ===");
+    REGISTRO_INFO("Resultados exportados para: resultados_escalabilidade_fw.csv");
+}
+
+vector<MedicaoEscalabilidade> medirEscalabilidade(const string &caminho_arquivo, const vector<int> &contagens_threads, int repeticoes)
+{
+    Grafo grafo;
+    grafo.lerArquivoDados(caminho_arquivo);
+
+    vector<MedicaoEscalabilidade> medicoes;
+    double tempo_base = 0.0;
+
+    for (int num_threads : contagens_threads)
+    {
+        definirNumThreads(num_threads);
+
+        // Menor tempo de parede entre as repetições (clock() somaria o tempo de todas as threads)
+        double melhor_tempo = numeric_limits<double>::infinity();
+        for (int r = 0; r < repeticoes; r++)
+        {
+            auto inicio = chrono::steady_clock::now();
+            grafo.calcularCaminhosMaisCurtos();
+            chrono::duration<double> duracao = chrono::steady_clock::now() - inicio;
+            melhor_tempo = min(melhor_tempo, duracao.count());
+        }
+
+        if (medicoes.empty())
+        {
+            tempo_base = melhor_tempo;
+        }
+
+        MedicaoEscalabilidade m;
+        m.instancia = grafo.getNome();
+        m.num_vertices = grafo.getNumVertices();
+        m.num_threads = num_threads;
+        m.tempo_segundos = melhor_tempo;
+        m.aceleracao = melhor_tempo > 0 ? tempo_base / melhor_tempo : 0.0;
+        m.eficiencia = m.aceleracao / num_threads;
+        medicoes.push_back(m);
+    }
+
+    return medicoes;
+}
+
+void exportarEscalabilidadeCSV(const vector<MedicaoEscalabilidade> &medicoes, const string &arquivo_saida)
+{
+    ofstream arquivo(arquivo_saida);
+
+    if (!arquivo.is_open())
+    {
+        throw runtime_error("Não foi possível criar o arquivo: " + arquivo_saida);
+    }
+
+    // Cabeçalho
+    arquivo << "Instancia,Vertices,Threads,TempoSegundos,Aceleracao,Eficiencia\n";
+
+    for (const auto &m : medicoes)
+    {
+        arquivo << m.instancia << ","
+                << m.num_vertices << ","
+                << m.num_threads << ","
+                << fixed << setprecision(6) << m.tempo_segundos << ","
+                << setprecision(3) << m.aceleracao << ","
+                << m.eficiencia << "\n";
+    }
+
+    arquivo.close();
+}
@@ -0,0 +1,28 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "../core/grafo.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Tempo do Floyd-Warshall paralelo para um número de threads
+struct MedicaoEscalabilidade
+{
+    string instancia;
+    int num_vertices;
+    int num_threads;
+    double tempo_segundos;
+    double aceleracao; // Relativa a 1 thread
+    double eficiencia; // aceleracao / num_threads
+};
+
+// Mede a escalabilidade do Floyd-Warshall de 1 até N threads nas maiores instâncias
+void executarBenchmarkFloydWarshall();
+
+// Funções auxiliares
+vector<MedicaoEscalabilidade> medirEscalabilidade(const string &caminho_arquivo, const vector<int> &contagens_threads, int repeticoes);
+void exportarEscalabilidadeCSV(const vector<MedicaoEscalabilidade> &medicoes, const string &arquivo_saida);
+
+#endif // BENCHMARK_H
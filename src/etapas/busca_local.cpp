@@ -0,0 +1,630 @@
+#include "busca_local.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+// Trecho de rota visto como um bloco: custo interno (deslocamentos entre os
+// seus serviços mais os custos de serviço), carga e os nós por onde entra e sai
+struct Segmento
+{
+    long long custo;
+    long long carga;
+    int entrada;
+    int saida;
+    bool vazio;
+};
+
+// Somas prefixas de uma rota. Posições 1..n são os serviços; 0 e n + 1, o depósito.
+struct DadosRota
+{
+    vector<int> entrada, saida;
+    vector<long long> direto;  // Deslocamentos 0→1→...→k
+    vector<long long> inverso; // Deslocamentos entre 1..k percorridos de trás para a frente
+    vector<long long> virado;  // Idem, com cada serviço também no sentido contrário
+    vector<int> arcos;         // Arcos (serviços que não podem ser virados) em 1..k
+    vector<long long> servico; // Custos de serviço de 1..k
+    vector<long long> carga;   // Demandas de 1..k
+    long long custo;
+
+    int tamanho() const { return (int)entrada.size() - 2; }
+};
+
+enum TipoMovimento
+{
+    MOVIMENTO_CROSS, // Troca dos trechos a1..a1+l1-1 e a2..a2+l2-1 (l = 0: inserção antes de a)
+    MOVIMENTO_DOIS_OPT_ESTRELA // Corte depois de a1 e a2; invertido: começos trocados e invertidos
+};
+
+struct MovimentoEntreRotas
+{
+    long long delta = 0;
+    TipoMovimento tipo = MOVIMENTO_CROSS;
+    int a1 = 0, l1 = 0, a2 = 0, l2 = 0;
+    bool inverte1 = false; // CROSS: trecho da rota 1 entra invertido na rota 2
+    bool inverte2 = false; // CROSS: trecho da rota 2 entra invertido na rota 1; 2-opt*: variante invertida
+};
+
+// Cadeia a..b da rota de origem levada para depois da posição destino da rota
+// alvo (posições da rota antes do movimento se alvo for a própria origem)
+struct MovimentoOrOpt
+{
+    long long delta = 0;
+    int a = 0, b = 0, destino = 0;
+    bool virado = false;
+};
+
+static void prepararDados(const Grafo &grafo, const Rota &rota, DadosRota &dados)
+{
+    const vector<Servico> &servicos = grafo.getServicos();
+    const int deposito = grafo.getDeposito();
+    const int n = rota.nos.size();
+
+    dados.entrada.resize(n + 2);
+    dados.saida.resize(n + 2);
+    dados.direto.resize(n + 2);
+    dados.inverso.resize(n + 2);
+    dados.virado.resize(n + 2);
+    dados.arcos.resize(n + 2);
+    dados.servico.resize(n + 2);
+    dados.carga.resize(n + 2);
+
+    dados.entrada[0] = dados.saida[0] = deposito;
+    dados.entrada[n + 1] = dados.saida[n + 1] = deposito;
+    dados.servico[0] = dados.carga[0] = dados.arcos[0] = 0;
+    for (int k = 1; k <= n; k++)
+    {
+        const auto &[id_servico, no_entrada] = rota.nos[k - 1];
+        const Servico &servico = servicos[id_servico - 1];
+        dados.entrada[k] = no_entrada;
+        dados.saida[k] = noDeSaida(servico, no_entrada);
+        dados.servico[k] = dados.servico[k - 1] + servico.custo_servico;
+        dados.carga[k] = dados.carga[k - 1] + servico.demanda;
+        dados.arcos[k] = dados.arcos[k - 1] + (servico.tipo == 'A');
+    }
+    dados.servico[n + 1] = dados.servico[n];
+    dados.carga[n + 1] = dados.carga[n];
+    dados.arcos[n + 1] = dados.arcos[n];
+
+    dados.direto[0] = dados.inverso[0] = dados.inverso[1] = dados.virado[0] = dados.virado[1] = 0;
+    for (int k = 1; k <= n + 1; k++)
+    {
+        dados.direto[k] = dados.direto[k - 1] + grafo.getDistancia(dados.saida[k - 1], dados.entrada[k]);
+    }
+    for (int k = 2; k <= n; k++)
+    {
+        dados.inverso[k] = dados.inverso[k - 1] + grafo.getDistancia(dados.saida[k], dados.entrada[k - 1]);
+        dados.virado[k] = dados.virado[k - 1] + grafo.getDistancia(dados.entrada[k], dados.saida[k - 1]);
+    }
+    dados.custo = dados.direto[n + 1] + dados.servico[n + 1];
+}
+
+// Posições a..b da rota na ordem da rota (podem incluir o depósito)
+static Segmento trecho(const DadosRota &dados, int a, int b)
+{
+    if (a > b)
+    {
+        return {0, 0, 0, 0, true};
+    }
+    long long servico = dados.servico[b] - (a > 0 ? dados.servico[a - 1] : 0);
+    long long carga = dados.carga[b] - (a > 0 ? dados.carga[a - 1] : 0);
+    return {dados.direto[b] - dados.direto[a] + servico, carga, dados.entrada[a], dados.saida[b], false};
+}
+
+// Serviços a..b (1 <= a, b <= n) de trás para a frente, cada um no seu sentido
+static Segmento trechoInvertido(const DadosRota &dados, int a, int b)
+{
+    if (a > b)
+    {
+        return {0, 0, 0, 0, true};
+    }
+    long long servico = dados.servico[b] - dados.servico[a - 1];
+    long long carga = dados.carga[b] - dados.carga[a - 1];
+    return {dados.inverso[b] - dados.inverso[a] + servico, carga, dados.entrada[b], dados.saida[a], false};
+}
+
+// Serviços a..b (1 <= a <= b <= n) de trás para a frente e virados: cada um entra
+// por onde saía. Só vale se o trecho não tiver arcos.
+static Segmento trechoVirado(const DadosRota &dados, int a, int b)
+{
+    long long servico = dados.servico[b] - dados.servico[a - 1];
+    long long carga = dados.carga[b] - dados.carga[a - 1];
+    return {dados.virado[b] - dados.virado[a] + servico, carga, dados.saida[b], dados.entrada[a], false};
+}
+
+static Segmento concatenar(const Grafo &grafo, const Segmento &primeiro, const Segmento &segundo)
+{
+    if (primeiro.vazio)
+    {
+        return segundo;
+    }
+    if (segundo.vazio)
+    {
+        return primeiro;
+    }
+    return {primeiro.custo + grafo.getDistancia(primeiro.saida, segundo.entrada) + segundo.custo,
+            primeiro.carga + segundo.carga, primeiro.entrada, segundo.saida, false};
+}
+
+// Custo da rota inicio + meio + fim
+static long long custoConcatenado(const Grafo &grafo, const Segmento &inicio, const Segmento &meio,
+                                  const Segmento &fim)
+{
+    return concatenar(grafo, concatenar(grafo, inicio, meio), fim).custo;
+}
+
+// Melhor movimento entre as rotas r1 e r2 com delta menor que melhor.delta
+static void avaliarPar(const Grafo &grafo, const DadosRota &r1, const DadosRota &r2, int tamanho_segmento,
+                       MovimentoEntreRotas &melhor)
+{
+    const long long capacidade = grafo.getCapacidade();
+    const int deposito = grafo.getDeposito();
+    const int n1 = r1.tamanho(), n2 = r2.tamanho();
+    const long long carga1 = r1.carga[n1 + 1], carga2 = r2.carga[n2 + 1];
+    const long long custo_atual = r1.custo + r2.custo;
+    const Segmento no_deposito = {0, 0, deposito, deposito, false};
+
+    // CROSS: o trecho a1..a1+l1-1 da rota 1 troca de lugar com a2..a2+l2-1 da
+    // rota 2; cada trecho entra na outra rota no sentido que sair mais barato
+    for (int l1 = 0; l1 <= min(tamanho_segmento, n1); l1++)
+    {
+        for (int a1 = 1; a1 + l1 <= n1 + 1; a1++)
+        {
+            Segmento inicio1 = trecho(r1, 0, a1 - 1), fim1 = trecho(r1, a1 + l1, n1 + 1);
+            Segmento meio1 = trecho(r1, a1, a1 + l1 - 1);
+            Segmento meio1_invertido = l1 >= 2 ? trechoInvertido(r1, a1, a1 + l1 - 1) : meio1;
+
+            for (int l2 = (l1 == 0 ? 1 : 0); l2 <= min(tamanho_segmento, n2); l2++)
+            {
+                for (int a2 = 1; a2 + l2 <= n2 + 1; a2++)
+                {
+                    Segmento meio2 = trecho(r2, a2, a2 + l2 - 1);
+                    if (carga1 - meio1.carga + meio2.carga > capacidade ||
+                        carga2 - meio2.carga + meio1.carga > capacidade)
+                    {
+                        continue;
+                    }
+                    Segmento inicio2 = trecho(r2, 0, a2 - 1), fim2 = trecho(r2, a2 + l2, n2 + 1);
+
+                    long long novo1 = custoConcatenado(grafo, inicio1, meio2, fim1);
+                    bool inverte2 = false;
+                    if (l2 >= 2)
+                    {
+                        long long invertido = custoConcatenado(grafo, inicio1, trechoInvertido(r2, a2, a2 + l2 - 1),
+                                                               fim1);
+                        if (invertido < novo1)
+                        {
+                            novo1 = invertido;
+                            inverte2 = true;
+                        }
+                    }
+                    long long novo2 = custoConcatenado(grafo, inicio2, meio1, fim2);
+                    bool inverte1 = false;
+                    if (l1 >= 2)
+                    {
+                        long long invertido = custoConcatenado(grafo, inicio2, meio1_invertido, fim2);
+                        if (invertido < novo2)
+                        {
+                            novo2 = invertido;
+                            inverte1 = true;
+                        }
+                    }
+
+                    long long delta = novo1 + novo2 - custo_atual;
+                    if (delta < melhor.delta)
+                    {
+                        melhor = {delta, MOVIMENTO_CROSS, a1, l1, a2, l2, inverte1, inverte2};
+                    }
+                }
+            }
+        }
+    }
+
+    // 2-opt*: cortes depois de a1 e de a2. Direto: cada rota fica com o seu
+    // começo e o final da outra. Invertido: uma fica com os dois começos (o da
+    // outra de trás para a frente) e a outra com os dois finais.
+    for (int a1 = 0; a1 <= n1; a1++)
+    {
+        Segmento inicio1 = trecho(r1, 0, a1), fim1 = trecho(r1, a1 + 1, n1 + 1);
+        Segmento meio1_invertido = trechoInvertido(r1, a1 + 1, n1);
+        for (int a2 = 0; a2 <= n2; a2++)
+        {
+            Segmento inicio2 = trecho(r2, 0, a2), fim2 = trecho(r2, a2 + 1, n2 + 1);
+
+            if (inicio1.carga + fim2.carga <= capacidade && inicio2.carga + fim1.carga <= capacidade)
+            {
+                long long delta = concatenar(grafo, inicio1, fim2).custo + concatenar(grafo, inicio2, fim1).custo -
+                                  custo_atual;
+                if (delta < melhor.delta)
+                {
+                    melhor = {delta, MOVIMENTO_DOIS_OPT_ESTRELA, a1, 0, a2, 0, false, false};
+                }
+            }
+
+            if (inicio1.carga + inicio2.carga <= capacidade && fim1.carga + fim2.carga <= capacidade)
+            {
+                long long delta = custoConcatenado(grafo, inicio1, trechoInvertido(r2, 1, a2), no_deposito) +
+                                  custoConcatenado(grafo, no_deposito, meio1_invertido, fim2) - custo_atual;
+                if (delta < melhor.delta)
+                {
+                    melhor = {delta, MOVIMENTO_DOIS_OPT_ESTRELA, a1, 0, a2, 0, false, true};
+                }
+            }
+        }
+    }
+}
+
+// Acrescenta os serviços das posições a..b da rota (só as que existem)
+static void anexarTrecho(vector<pair<int, int>> &destino, const Rota &rota, int a, int b, bool invertido)
+{
+    a = max(a, 1);
+    b = min(b, (int)rota.nos.size());
+    if (invertido)
+    {
+        for (int k = b; k >= a; k--)
+        {
+            destino.push_back(rota.nos[k - 1]);
+        }
+    }
+    else
+    {
+        for (int k = a; k <= b; k++)
+        {
+            destino.push_back(rota.nos[k - 1]);
+        }
+    }
+}
+
+static void aplicarMovimento(const MovimentoEntreRotas &movimento, Rota &rota1, Rota &rota2)
+{
+    const int n1 = rota1.nos.size(), n2 = rota2.nos.size();
+    vector<pair<int, int>> nova1, nova2;
+    if (movimento.tipo == MOVIMENTO_CROSS)
+    {
+        anexarTrecho(nova1, rota1, 1, movimento.a1 - 1, false);
+        anexarTrecho(nova1, rota2, movimento.a2, movimento.a2 + movimento.l2 - 1, movimento.inverte2);
+        anexarTrecho(nova1, rota1, movimento.a1 + movimento.l1, n1, false);
+        anexarTrecho(nova2, rota2, 1, movimento.a2 - 1, false);
+        anexarTrecho(nova2, rota1, movimento.a1, movimento.a1 + movimento.l1 - 1, movimento.inverte1);
+        anexarTrecho(nova2, rota2, movimento.a2 + movimento.l2, n2, false);
+    }
+    else if (!movimento.inverte2)
+    {
+        anexarTrecho(nova1, rota1, 1, movimento.a1, false);
+        anexarTrecho(nova1, rota2, movimento.a2 + 1, n2, false);
+        anexarTrecho(nova2, rota2, 1, movimento.a2, false);
+        anexarTrecho(nova2, rota1, movimento.a1 + 1, n1, false);
+    }
+    else
+    {
+        anexarTrecho(nova1, rota1, 1, movimento.a1, false);
+        anexarTrecho(nova1, rota2, 1, movimento.a2, true);
+        anexarTrecho(nova2, rota1, movimento.a1 + 1, n1, true);
+        anexarTrecho(nova2, rota2, movimento.a2 + 1, n2, false);
+    }
+    rota1.nos = move(nova1);
+    rota2.nos = move(nova2);
+}
+
+MovimentosEntreRotas melhorarEntreRotas(const Grafo &grafo, vector<Rota> &rotas, int tamanho_segmento)
+{
+    MovimentosEntreRotas movimentos;
+    const int num_rotas = rotas.size();
+
+    vector<DadosRota> dados(num_rotas);
+    for (int r = 0; r < num_rotas; r++)
+    {
+        prepararDados(grafo, rotas[r], dados[r]);
+    }
+
+    // Um par só é varrido de novo se uma das rotas mudou desde a última
+    // varredura sem melhoria (versões guardadas em examinado)
+    vector<int> versao(num_rotas, 0);
+    vector<pair<int, int>> examinado((size_t)num_rotas * num_rotas, {-1, -1});
+
+    bool melhorou = true;
+    while (melhorou)
+    {
+        melhorou = false;
+        for (int r1 = 0; r1 < num_rotas; r1++)
+        {
+            for (int r2 = r1 + 1; r2 < num_rotas; r2++)
+            {
+                pair<int, int> &visto = examinado[(size_t)r1 * num_rotas + r2];
+                if (visto == make_pair(versao[r1], versao[r2]))
+                {
+                    continue;
+                }
+
+                MovimentoEntreRotas movimento;
+                avaliarPar(grafo, dados[r1], dados[r2], tamanho_segmento, movimento);
+                if (movimento.delta >= 0)
+                {
+                    visto = {versao[r1], versao[r2]};
+                    continue;
+                }
+
+                aplicarMovimento(movimento, rotas[r1], rotas[r2]);
+                for (int r : {r1, r2})
+                {
+                    prepararDados(grafo, rotas[r], dados[r]);
+                    rotas[r].custo_total = dados[r].custo;
+                    rotas[r].demanda_total = dados[r].carga.back();
+                    versao[r]++;
+                }
+                melhorou = true;
+
+                if (movimento.tipo == MOVIMENTO_DOIS_OPT_ESTRELA)
+                {
+                    movimentos.dois_opt_estrela++;
+                }
+                else if (movimento.l1 + movimento.l2 == 1)
+                {
+                    movimentos.realocacoes++;
+                }
+                else if (movimento.l1 == 1 && movimento.l2 == 1)
+                {
+                    movimentos.trocas++;
+                }
+                else
+                {
+                    movimentos.cross++;
+                }
+            }
+        }
+    }
+
+    rotas.erase(remove_if(rotas.begin(), rotas.end(), [](const Rota &rota) { return rota.nos.empty(); }),
+                rotas.end());
+    return movimentos;
+}
+
+// Melhor Or-opt das cadeias de até 3 serviços da origem para a rota alvo
+// (alvo == origem: mudança de posição na mesma rota, inclusive só virar a
+// cadeia no lugar). Cadeias sem arcos também são testadas viradas.
+static void avaliarOrOpt(const Grafo &grafo, const DadosRota &origem, const DadosRota &alvo, MovimentoOrOpt &melhor)
+{
+    const long long capacidade = grafo.getCapacidade();
+    const int n = origem.tamanho(), n_alvo = alvo.tamanho();
+    const bool mesma_rota = &origem == &alvo;
+
+    for (int a = 1; a <= n; a++)
+    {
+        for (int b = a; b <= min(n, a + 2); b++)
+        {
+            Segmento cadeias[2] = {trecho(origem, a, b), trechoVirado(origem, a, b)};
+            int num_cadeias = origem.arcos[b] - origem.arcos[a - 1] == 0 ? 2 : 1;
+
+            if (mesma_rota)
+            {
+                Segmento inicio = trecho(origem, 0, a - 1), fim = trecho(origem, b + 1, n + 1);
+                for (int v = 0; v < num_cadeias; v++)
+                {
+                    const Segmento &cadeia = cadeias[v];
+                    for (int destino = 0; destino <= n; destino++)
+                    {
+                        long long novo;
+                        if (destino < a - 1)
+                        {
+                            novo = concatenar(grafo, concatenar(grafo, trecho(origem, 0, destino), cadeia),
+                                              concatenar(grafo, trecho(origem, destino + 1, a - 1), fim)).custo;
+                        }
+                        else if (destino > b)
+                        {
+                            novo = concatenar(grafo, concatenar(grafo, inicio, trecho(origem, b + 1, destino)),
+                                              concatenar(grafo, cadeia, trecho(origem, destino + 1, n + 1))).custo;
+                        }
+                        else if (destino == a - 1 && v == 1)
+                        {
+                            novo = custoConcatenado(grafo, inicio, cadeia, fim);
+                        }
+                        else
+                        {
+                            continue;
+                        }
+                        if (novo - origem.custo < melhor.delta)
+                        {
+                            melhor = {novo - origem.custo, a, b, destino, v == 1};
+                        }
+                    }
+                }
+                continue;
+            }
+
+            if (alvo.carga[n_alvo + 1] + cadeias[0].carga > capacidade)
+            {
+                continue;
+            }
+            long long sem_cadeia = concatenar(grafo, trecho(origem, 0, a - 1), trecho(origem, b + 1, n + 1)).custo;
+            long long base = sem_cadeia - origem.custo - alvo.custo;
+            for (int v = 0; v < num_cadeias; v++)
+            {
+                for (int destino = 0; destino <= n_alvo; destino++)
+                {
+                    long long delta = base + custoConcatenado(grafo, trecho(alvo, 0, destino), cadeias[v],
+                                                              trecho(alvo, destino + 1, n_alvo + 1));
+                    if (delta < melhor.delta)
+                    {
+                        melhor = {delta, a, b, destino, v == 1};
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void aplicarOrOpt(const Grafo &grafo, const MovimentoOrOpt &movimento, Rota &origem, Rota &alvo)
+{
+    const vector<Servico> &servicos = grafo.getServicos();
+    vector<pair<int, int>> cadeia(origem.nos.begin() + movimento.a - 1, origem.nos.begin() + movimento.b);
+    if (movimento.virado)
+    {
+        reverse(cadeia.begin(), cadeia.end());
+        for (auto &[id_servico, no_entrada] : cadeia)
+        {
+            no_entrada = noDeSaida(servicos[id_servico - 1], no_entrada);
+        }
+    }
+    origem.nos.erase(origem.nos.begin() + movimento.a - 1, origem.nos.begin() + movimento.b);
+
+    // Na mesma rota, destinos depois da cadeia recuam com a remoção
+    int posicao = movimento.destino;
+    if (&origem == &alvo && posicao > movimento.b)
+    {
+        posicao -= movimento.b - movimento.a + 1;
+    }
+    alvo.nos.insert(alvo.nos.begin() + posicao, cadeia.begin(), cadeia.end());
+}
+
+int melhorarOrOpt(const Grafo &grafo, vector<Rota> &rotas)
+{
+    int movimentos = 0;
+    const int num_rotas = rotas.size();
+
+    vector<DadosRota> dados(num_rotas);
+    for (int r = 0; r < num_rotas; r++)
+    {
+        prepararDados(grafo, rotas[r], dados[r]);
+    }
+
+    // Pares ordenados (origem, alvo), com origem == alvo para a mesma rota;
+    // pulados como em melhorarEntreRotas enquanto as duas rotas não mudarem
+    vector<int> versao(num_rotas, 0);
+    vector<pair<int, int>> examinado((size_t)num_rotas * num_rotas, {-1, -1});
+
+    bool melhorou = true;
+    while (melhorou)
+    {
+        melhorou = false;
+        for (int origem = 0; origem < num_rotas; origem++)
+        {
+            for (int alvo = 0; alvo < num_rotas; alvo++)
+            {
+                pair<int, int> &visto = examinado[(size_t)origem * num_rotas + alvo];
+                if (visto == make_pair(versao[origem], versao[alvo]))
+                {
+                    continue;
+                }
+
+                MovimentoOrOpt movimento;
+                avaliarOrOpt(grafo, dados[origem], dados[alvo], movimento);
+                if (movimento.delta >= 0)
+                {
+                    visto = {versao[origem], versao[alvo]};
+                    continue;
+                }
+
+                aplicarOrOpt(grafo, movimento, rotas[origem], rotas[alvo]);
+                for (int r : {origem, alvo})
+                {
+                    prepararDados(grafo, rotas[r], dados[r]);
+                    rotas[r].custo_total = dados[r].custo;
+                    rotas[r].demanda_total = dados[r].carga.back();
+                    versao[r]++;
+                }
+                movimentos++;
+                melhorou = true;
+            }
+        }
+    }
+
+    rotas.erase(remove_if(rotas.begin(), rotas.end(), [](const Rota &rota) { return rota.nos.empty(); }),
+                rotas.end());
+    return movimentos;
+}
+
+// Sentido 0: entra pela origem; sentido 1 (só arestas): entra pelo destino
+static int numSentidos(const Servico &servico)
+{
+    return (servico.tipo == 'E' && servico.origem != servico.destino) ? 2 : 1;
+}
+
+bool orientarRota(const Grafo &grafo, Rota &rota)
+{
+    const vector<Servico> &servicos = grafo.getServicos();
+    const int deposito = grafo.getDeposito();
+    const int n = rota.nos.size();
+    if (n == 0)
+    {
+        return false;
+    }
+
+    // custo[k][s]: menor custo do depósito até o fim do serviço k feito no
+    // sentido s; veio[k][s]: sentido do serviço k - 1 nesse caminho
+    vector<array<long long, 2>> custo(n);
+    vector<array<int, 2>> veio(n);
+    long long custo_atual = 0;
+    int no_atual = deposito;
+    for (int k = 0; k < n; k++)
+    {
+        const Servico &servico = servicos[rota.nos[k].first - 1];
+        custo_atual += grafo.getDistancia(no_atual, rota.nos[k].second) + servico.custo_servico;
+        no_atual = noDeSaida(servico, rota.nos[k].second);
+
+        for (int s = 0; s < numSentidos(servico); s++)
+        {
+            int entrada = s ? servico.destino : servico.origem;
+            if (k == 0)
+            {
+                custo[k][s] = grafo.getDistancia(deposito, entrada);
+                veio[k][s] = 0;
+            }
+            else
+            {
+                const Servico &anterior = servicos[rota.nos[k - 1].first - 1];
+                custo[k][s] = -1;
+                for (int t = 0; t < numSentidos(anterior); t++)
+                {
+                    int saida = noDeSaida(anterior, t ? anterior.destino : anterior.origem);
+                    long long valor = custo[k - 1][t] + grafo.getDistancia(saida, entrada);
+                    if (custo[k][s] < 0 || valor < custo[k][s])
+                    {
+                        custo[k][s] = valor;
+                        veio[k][s] = t;
+                    }
+                }
+            }
+            custo[k][s] += servico.custo_servico;
+        }
+    }
+    custo_atual += grafo.getDistancia(no_atual, deposito);
+
+    const Servico &ultimo = servicos[rota.nos[n - 1].first - 1];
+    long long melhor = -1;
+    int sentido = 0;
+    for (int s = 0; s < numSentidos(ultimo); s++)
+    {
+        long long valor = custo[n - 1][s] + grafo.getDistancia(noDeSaida(ultimo, s ? ultimo.destino : ultimo.origem),
+                                                               deposito);
+        if (melhor < 0 || valor < melhor)
+        {
+            melhor = valor;
+            sentido = s;
+        }
+    }
+    if (melhor >= custo_atual)
+    {
+        return false;
+    }
+
+    for (int k = n - 1; k >= 0; k--)
+    {
+        const Servico &servico = servicos[rota.nos[k].first - 1];
+        rota.nos[k].second = sentido ? servico.destino : servico.origem;
+        sentido = veio[k][sentido];
+    }
+    rota.custo_total = melhor;
+    return true;
+}
+
+int orientarRotas(const Grafo &grafo, vector<Rota> &rotas, int num_threads)
+{
+    atomic<int> melhoradas(0);
+    paraleloPara(0, rotas.size(), num_threads, [&](int r, int)
+    {
+        if (orientarRota(grafo, rotas[r]))
+        {
+            melhoradas++;
+        }
+    });
+    return melhoradas;
+}
@@ -0,0 +1,44 @@
+#ifndef BUSCA_LOCAL_H
+#define BUSCA_LOCAL_H
+
+#include "etapa2.h"
+#include <vector>
+
+using namespace std;
+
+// Movimentos entre rotas aplicados por melhorarEntreRotas, por vizinhança
+struct MovimentosEntreRotas
+{
+    int realocacoes = 0;     // Um serviço muda de rota
+    int trocas = 0;          // Dois serviços trocam de rota
+    int dois_opt_estrela = 0; // Troca dos finais (ou começos invertidos) de duas rotas
+    int cross = 0;           // Troca de trechos de até tamanho_segmento serviços
+
+    int total() const { return realocacoes + trocas + dois_opt_estrela + cross; }
+};
+
+// Busca local entre pares de rotas: relocate, swap, 2-opt* e CROSS-exchange
+// (relocate e swap são os casos 1-0 e 1-1 do CROSS). Cada rota guarda somas
+// prefixas de carga e de custo nos dois sentidos de percurso, e qualquer trecho
+// contíguo vira um segmento (custo, carga, nó de entrada, nó de saída), também
+// lido de trás para a frente mantendo o sentido de cada serviço. Um movimento
+// só concatena segmentos, então custo e capacidade saem em O(1), sem copiar
+// rotas. Cada par é varrido inteiro e o melhor movimento aplicado; pares cujas
+// rotas não mudaram desde a última varredura sem melhoria são pulados. Para
+// quando nenhum par melhora. Rotas que ficam vazias são removidas.
+MovimentosEntreRotas melhorarEntreRotas(const Grafo &grafo, vector<Rota> &rotas, int tamanho_segmento = 3);
+
+// Or-opt: cadeias de 1 a 3 serviços consecutivos mudam de posição na mesma
+// rota ou vão para outra, na ordem original ou de trás para a frente com cada
+// serviço virado (só cadeias sem arcos). Avaliação O(1) pelos mesmos segmentos
+// e mesma estratégia de melhorarEntreRotas. Retorna o número de movimentos.
+int melhorarOrOpt(const Grafo &grafo, vector<Rota> &rotas);
+
+// Sentido ótimo das arestas de uma rota, com a ordem dos serviços fixa:
+// programação dinâmica de dois estados por serviço (entrar pela origem ou pelo
+// destino), O(n). Só altera a rota se o custo cair; retorna true nesse caso.
+bool orientarRota(const Grafo &grafo, Rota &rota);
+// orientarRota em cada rota, em paralelo; retorna quantas rotas melhoraram
+int orientarRotas(const Grafo &grafo, vector<Rota> &rotas, int num_threads = obterNumThreads());
+
+#endif // BUSCA_LOCAL_H
@@ -0,0 +1,230 @@
+#include "divisao.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+static const long long CUSTO_DIVISAO_INFINITO = numeric_limits<long long>::max() / 4;
+
+// Sentidos possíveis de um serviço: só arestas podem ser invertidas
+static int numSentidos(const Servico &servico)
+{
+    return (servico.tipo == 'E' && servico.origem != servico.destino) ? 2 : 1;
+}
+
+static ServicoOrientado inverter(const ServicoOrientado &s)
+{
+    return {s.id_servico, s.saida, s.entrada};
+}
+
+Rota montarRota(const Grafo &grafo, const vector<ServicoOrientado> &visitas)
+{
+    const vector<Servico> &servicos = grafo.getServicos();
+    int deposito = grafo.getDeposito();
+
+    Rota rota;
+    int no_atual = deposito;
+    for (const ServicoOrientado &visita : visitas)
+    {
+        const Servico &atendido = servicos[visita.id_servico - 1];
+        rota.nos.push_back({visita.id_servico, visita.entrada});
+        rota.demanda_total += atendido.demanda;
+        rota.custo_total += grafo.getDistancia(no_atual, visita.entrada) + atendido.custo_servico;
+        no_atual = visita.saida;
+    }
+    rota.custo_total += grafo.getDistancia(no_atual, deposito);
+    return rota;
+}
+
+Solucao dividirVoltaGigante(const Grafo &grafo, const vector<ServicoOrientado> &volta, AreaDivisao &area)
+{
+    const vector<Servico> &servicos = grafo.getServicos();
+    const int deposito = grafo.getDeposito();
+    const long long capacidade = grafo.getCapacidade();
+    const int n = volta.size();
+
+    auto distancia = [&](int origem, int destino) -> long long { return grafo.getDistancia(origem, destino); };
+    // Serviço k da volta (1..n)
+    auto s = [&](int k) -> const ServicoOrientado & { return volta[k - 1]; };
+    auto servico = [&](int k) -> const Servico & { return servicos[volta[k - 1].id_servico - 1]; };
+
+    area.acumulado.assign(n + 1, 0);
+    area.ate_seguinte.assign(n + 1, 0);
+    area.carga.assign(n + 1, 0);
+    area.valor.assign(n + 1, CUSTO_DIVISAO_INFINITO);
+    area.potencial.assign(n + 1, 0);
+    area.predecessor.assign(n + 1, -1);
+    area.fila.resize(n + 1);
+
+    for (int k = 1; k <= n; k++)
+    {
+        area.acumulado[k] = area.ate_seguinte[k - 1] + servico(k).custo_servico;
+        area.ate_seguinte[k] = area.acumulado[k] + (k < n ? distancia(s(k).saida, s(k + 1).entrada) : 0);
+        area.carga[k] = area.carga[k - 1] + servico(k).demanda;
+        if (servico(k).demanda > capacidade)
+        {
+            throw runtime_error("Serviço " + to_string(s(k).id_servico) + " tem demanda acima da capacidade");
+        }
+    }
+
+    // Chegada do depósito ao primeiro serviço de uma rota longa que começa em
+    // t + 1, já descontado o deslocamento até t + 2 que o acumulado conta. A
+    // aresta pode ser invertida: entra pela saída e segue da entrada.
+    auto partida = [&](int t, bool *inverte) -> long long
+    {
+        const ServicoOrientado &primeiro = s(t + 1);
+        int seguinte = s(t + 2).entrada;
+        long long direto = distancia(deposito, primeiro.entrada);
+        *inverte = false;
+        if (numSentidos(servico(t + 1)) == 2)
+        {
+            long long invertido = distancia(deposito, primeiro.saida) + distancia(primeiro.entrada, seguinte) -
+                                  distancia(primeiro.saida, seguinte);
+            if (invertido < direto)
+            {
+                *inverte = true;
+                return invertido;
+            }
+        }
+        return direto;
+    };
+
+    // Volta ao depósito depois do último serviço j de uma rota longa, com a
+    // mesma correção para a aresta invertida (o acumulado chega à entrada de j)
+    auto retorno = [&](int j, bool *inverte) -> long long
+    {
+        const ServicoOrientado &ultimo = s(j);
+        int anterior = s(j - 1).saida;
+        long long direto = distancia(ultimo.saida, deposito);
+        *inverte = false;
+        if (numSentidos(servico(j)) == 2)
+        {
+            long long invertido = distancia(anterior, ultimo.saida) - distancia(anterior, ultimo.entrada) +
+                                  distancia(ultimo.entrada, deposito);
+            if (invertido < direto)
+            {
+                *inverte = true;
+                return invertido;
+            }
+        }
+        return direto;
+    };
+
+    // Rota curta (serviços t + 1..j, j - t <= 2): todos os sentidos são testados
+    auto rotaCurta = [&](int t, int j, ServicoOrientado *escolhidos) -> long long
+    {
+        long long melhor = CUSTO_DIVISAO_INFINITO;
+        int sentidos_primeiro = numSentidos(servico(t + 1));
+        int sentidos_segundo = j - t == 2 ? numSentidos(servico(j)) : 1;
+        for (int a = 0; a < sentidos_primeiro; a++)
+        {
+            ServicoOrientado primeiro = a ? inverter(s(t + 1)) : s(t + 1);
+            for (int b = 0; b < sentidos_segundo; b++)
+            {
+                long long custo = distancia(deposito, primeiro.entrada) + servico(t + 1).custo_servico;
+                ServicoOrientado ultimo = primeiro;
+                if (j - t == 2)
+                {
+                    ultimo = b ? inverter(s(j)) : s(j);
+                    custo += distancia(primeiro.saida, ultimo.entrada) + servico(j).custo_servico;
+                }
+                custo += distancia(ultimo.saida, deposito);
+                if (custo < melhor)
+                {
+                    melhor = custo;
+                    if (escolhidos)
+                    {
+                        escolhidos[0] = primeiro;
+                        escolhidos[1] = ultimo;
+                    }
+                }
+            }
+        }
+        return melhor;
+    };
+
+    // Fila dupla de predecessores t (rotas t + 1..j com 3 ou mais serviços):
+    // do início para o fim, t e potencial crescem. Um t maior com potencial
+    // menor ou igual domina os anteriores, que nunca têm mais folga de carga.
+    int inicio = 0, fim = 0;
+    area.valor[0] = 0;
+    bool inverte;
+
+    for (int j = 1; j <= n; j++)
+    {
+        if (j >= 3 && area.valor[j - 3] < CUSTO_DIVISAO_INFINITO)
+        {
+            int t = j - 3;
+            area.potencial[t] = area.valor[t] + partida(t, &inverte) - area.ate_seguinte[t];
+            while (fim > inicio && area.potencial[area.fila[fim - 1]] >= area.potencial[t])
+            {
+                fim--;
+            }
+            area.fila[fim++] = t;
+        }
+
+        // A carga de j só cresce: quem não cabe agora não cabe mais adiante
+        while (fim > inicio && area.carga[j] - area.carga[area.fila[inicio]] > capacidade)
+        {
+            inicio++;
+        }
+
+        if (fim > inicio)
+        {
+            int t = area.fila[inicio];
+            long long custo = area.potencial[t] + area.acumulado[j] + retorno(j, &inverte);
+            if (custo < area.valor[j])
+            {
+                area.valor[j] = custo;
+                area.predecessor[j] = t;
+            }
+        }
+
+        for (int t = max(0, j - 2); t < j; t++)
+        {
+            if (area.valor[t] < CUSTO_DIVISAO_INFINITO && area.carga[j] - area.carga[t] <= capacidade)
+            {
+                long long custo = area.valor[t] + rotaCurta(t, j, nullptr);
+                if (custo < area.valor[j])
+                {
+                    area.valor[j] = custo;
+                    area.predecessor[j] = t;
+                }
+            }
+        }
+    }
+
+    // Rotas de trás para a frente, com os sentidos escolhidos acima
+    Solucao solucao;
+    for (int j = n; j > 0; j = area.predecessor[j])
+    {
+        int t = area.predecessor[j];
+        vector<ServicoOrientado> trecho(volta.begin() + t, volta.begin() + j);
+        if (j - t <= 2)
+        {
+            ServicoOrientado escolhidos[2];
+            rotaCurta(t, j, escolhidos);
+            trecho.front() = escolhidos[0];
+            trecho.back() = escolhidos[1];
+        }
+        else
+        {
+            partida(t, &inverte);
+            if (inverte)
+            {
+                trecho.front() = inverter(trecho.front());
+            }
+            retorno(j, &inverte);
+            if (inverte)
+            {
+                trecho.back() = inverter(trecho.back());
+            }
+        }
+
+        solucao.rotas.push_back(montarRota(grafo, trecho));
+        solucao.custo_total += solucao.rotas.back().custo_total;
+    }
+
+    reverse(solucao.rotas.begin(), solucao.rotas.end());
+    solucao.num_rotas = solucao.rotas.size();
+    return solucao;
+}
@@ -0,0 +1,42 @@
+#ifndef DIVISAO_H
+#define DIVISAO_H
+
+#include "etapa2.h"
+#include <vector>
+
+using namespace std;
+
+// Serviço de uma volta gigante, com o sentido em que é executado
+struct ServicoOrientado
+{
+    int id_servico;
+    int entrada;
+    int saida;
+};
+
+// Rota que sai do depósito, executa as visitas na ordem e sentidos dados e volta
+Rota montarRota(const Grafo &grafo, const vector<ServicoOrientado> &visitas);
+
+// Vetores reaproveitados entre divisões (um por thread)
+struct AreaDivisao
+{
+    vector<long long> acumulado;    // Custo de 1..k na ordem e sentidos da volta
+    vector<long long> ate_seguinte; // acumulado[k] + deslocamento até o serviço k + 1
+    vector<long long> carga;
+    vector<long long> valor;        // Menor custo para atender 1..k
+    vector<long long> potencial;    // Termo do predecessor t nas rotas longas
+    vector<int> predecessor;
+    vector<int> fila;
+};
+
+// Divide a volta gigante em rotas que respeitam a capacidade, com custo total
+// mínimo para a ordem dada (cada rota é um trecho contíguo da volta). É o
+// algoritmo linear de Vidal (2016): rotas de 3 ou mais serviços têm custo
+// potencial(t) + acumulado(j) + retorno(j), e uma fila dupla mantém os
+// predecessores t não dominados dentro da capacidade. O sentido dos serviços
+// internos é o da volta; o primeiro e o último de cada rota (arestas) podem ser
+// invertidos, e rotas de 1 ou 2 serviços escolhem o sentido de cada um.
+// Lança runtime_error se algum serviço sozinho exceder a capacidade.
+Solucao dividirVoltaGigante(const Grafo &grafo, const vector<ServicoOrientado> &volta, AreaDivisao &area);
+
+#endif // DIVISAO_H
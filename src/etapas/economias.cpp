@@ -0,0 +1,304 @@
+#include "economias.h"
+#include "divisao.h"
+#include "../core/registro.h"
+#include <algorithm>
+#include <stdexcept>
+
+// Junção candidata: a rota que termina no serviço cauda (no sentido
+// sentido_cauda) seguida da que começa no serviço cabeca (em sentido_cabeca)
+struct EconomiaJuncao
+{
+    long long valor;
+    int cauda;
+    int cabeca;
+    int sentido_cauda;
+    int sentido_cabeca;
+
+    // Ordem do heap: maior economia primeiro; no empate, menores ids e sentidos
+    bool operator<(const EconomiaJuncao &outra) const
+    {
+        if (valor != outra.valor)
+        {
+            return valor < outra.valor;
+        }
+        if (cauda != outra.cauda)
+        {
+            return cauda > outra.cauda;
+        }
+        if (cabeca != outra.cabeca)
+        {
+            return cabeca > outra.cabeca;
+        }
+        if (sentido_cauda != outra.sentido_cauda)
+        {
+            return sentido_cauda > outra.sentido_cauda;
+        }
+        return sentido_cabeca > outra.sentido_cabeca;
+    }
+};
+
+// Junção de uma linha (cauda fixa) com o serviço cabeca_sentido / 2 no sentido
+// cabeca_sentido % 2. Ordem do heap da linha: maior economia, depois menor cabeça.
+struct EconomiaParceiro
+{
+    long long valor;
+    int cabeca_sentido;
+
+    bool operator<(const EconomiaParceiro &outra) const
+    {
+        if (valor != outra.valor)
+        {
+            return valor < outra.valor;
+        }
+        return cabeca_sentido > outra.cabeca_sentido;
+    }
+};
+
+// Sentido 0: entra pela origem; sentido 1 (só arestas): entra pelo destino
+static int numSentidos(const Servico &servico)
+{
+    return (servico.tipo == 'E' && servico.origem != servico.destino) ? 2 : 1;
+}
+
+static int entradaNoSentido(const Servico &servico, int sentido)
+{
+    return sentido ? servico.destino : servico.origem;
+}
+
+static int saidaNoSentido(const Servico &servico, int sentido)
+{
+    if (servico.tipo == 'N')
+    {
+        return servico.origem;
+    }
+    if (servico.tipo == 'A')
+    {
+        return servico.destino;
+    }
+    return sentido ? servico.origem : servico.destino;
+}
+
+Solucao solucaoEconomias(const Grafo &grafo, clock_t &inicio_execucao)
+{
+    clock_t inicio = inicio_execucao;
+    const vector<Servico> &servicos = grafo.getServicos();
+    const int deposito = grafo.getDeposito();
+    const long long capacidade = grafo.getCapacidade();
+    const int num_servicos = servicos.size();
+
+    REGISTRO_DEPURACAO("Iniciando construção por economias...");
+
+    auto distancia = [&](int origem, int destino) -> long long { return grafo.getDistancia(origem, destino); };
+
+    // Estado por serviço (índice = id): rota, sentido e vizinhos na rota
+    vector<int> rota_de(num_servicos + 1);
+    vector<int> sentido(num_servicos + 1, 0);
+    vector<int> proximo(num_servicos + 1, 0); // 0 = fim da rota
+    vector<int> anterior(num_servicos + 1, 0);
+
+    // Estado por rota (índice = id do serviço que a criou): pontas, carga e
+    // tamanho; invertivel se só tiver arestas e nós
+    vector<int> primeiro(num_servicos + 1), ultimo(num_servicos + 1), tamanho(num_servicos + 1, 1);
+    vector<long long> carga(num_servicos + 1);
+    vector<char> invertivel(num_servicos + 1);
+
+    for (int id = 1; id <= num_servicos; id++)
+    {
+        const Servico &servico = servicos[id - 1];
+        if (servico.demanda > capacidade)
+        {
+            throw runtime_error("Serviço " + to_string(id) + " tem demanda acima da capacidade");
+        }
+        rota_de[id] = primeiro[id] = ultimo[id] = id;
+        carga[id] = servico.demanda;
+        invertivel[id] = servico.tipo != 'A';
+    }
+
+    // Junções com economia positiva de cada cauda (serviço i no sentido si,
+    // linha 2 * i + si), cada linha organizada como um heap. O heap principal
+    // guarda só a melhor junção ainda não vista de cada linha; a linha inteira
+    // é abandonada quando i fica no meio de uma rota, de onde não sai mais.
+    vector<EconomiaParceiro> parceiros;
+    vector<size_t> inicio_linha(2 * (num_servicos + 1)), fim_linha(2 * (num_servicos + 1));
+    for (int i = 1; i <= num_servicos; i++)
+    {
+        const Servico &servico_i = servicos[i - 1];
+        for (int si = 0; si < numSentidos(servico_i); si++)
+        {
+            int linha = 2 * i + si;
+            inicio_linha[linha] = parceiros.size();
+            int saida = saidaNoSentido(servico_i, si);
+            long long ate_deposito = distancia(saida, deposito);
+            for (int j = 1; j <= num_servicos; j++)
+            {
+                const Servico &servico_j = servicos[j - 1];
+                if (j == i || servico_i.demanda + servico_j.demanda > capacidade)
+                {
+                    continue;
+                }
+                for (int sj = 0; sj < numSentidos(servico_j); sj++)
+                {
+                    int entrada = entradaNoSentido(servico_j, sj);
+                    long long valor = ate_deposito + distancia(deposito, entrada) - distancia(saida, entrada);
+                    if (valor > 0)
+                    {
+                        parceiros.push_back({valor, 2 * j + sj});
+                    }
+                }
+            }
+            fim_linha[linha] = parceiros.size();
+            make_heap(parceiros.begin() + inicio_linha[linha], parceiros.begin() + fim_linha[linha]);
+        }
+    }
+
+    REGISTRO_DEPURACAO("Economias positivas: " << parceiros.size());
+
+    vector<EconomiaJuncao> heap;
+    auto avancarLinha = [&](int i, int si)
+    {
+        int linha = 2 * i + si;
+        if (fim_linha[linha] == inicio_linha[linha])
+        {
+            return;
+        }
+        pop_heap(parceiros.begin() + inicio_linha[linha], parceiros.begin() + fim_linha[linha]);
+        const EconomiaParceiro &melhor = parceiros[--fim_linha[linha]];
+        heap.push_back({melhor.valor, i, melhor.cabeca_sentido / 2, si, melhor.cabeca_sentido % 2});
+        push_heap(heap.begin(), heap.end());
+    };
+    for (int i = 1; i <= num_servicos; i++)
+    {
+        for (int si = 0; si < numSentidos(servicos[i - 1]); si++)
+        {
+            avancarLinha(i, si);
+        }
+    }
+
+    // Inverte a ordem e o sentido dos serviços da rota (só rotas invertíveis)
+    auto inverterRota = [&](int rota)
+    {
+        for (int id = primeiro[rota]; id != 0; id = anterior[id])
+        {
+            swap(proximo[id], anterior[id]);
+            if (numSentidos(servicos[id - 1]) == 2)
+            {
+                sentido[id] ^= 1;
+            }
+        }
+        swap(primeiro[rota], ultimo[rota]);
+    };
+
+    // Como deixar id na ponta pedida da sua rota com o sentido s:
+    // 0 = já está, 1 = invertendo a rota, -1 = impossível. Rota de um só
+    // serviço: o sentido é livre.
+    auto ajustePonta = [&](int id, int s, bool no_fim) -> int
+    {
+        int rota = rota_de[id];
+        if (tamanho[rota] == 1)
+        {
+            return 0;
+        }
+        int ponta = no_fim ? ultimo[rota] : primeiro[rota];
+        int oposta = no_fim ? primeiro[rota] : ultimo[rota];
+        if (ponta == id && sentido[id] == s)
+        {
+            return 0;
+        }
+        if (invertivel[rota] && oposta == id && (sentido[id] ^ (numSentidos(servicos[id - 1]) == 2)) == s)
+        {
+            return 1;
+        }
+        return -1;
+    };
+
+    int juncoes = 0;
+    while (!heap.empty())
+    {
+        pop_heap(heap.begin(), heap.end());
+        EconomiaJuncao juncao = heap.back();
+        heap.pop_back();
+
+        if (anterior[juncao.cauda] != 0 && proximo[juncao.cauda] != 0)
+        {
+            continue;
+        }
+        avancarLinha(juncao.cauda, juncao.sentido_cauda);
+
+        int rota_cauda = rota_de[juncao.cauda];
+        int rota_cabeca = rota_de[juncao.cabeca];
+        if (rota_cauda == rota_cabeca || carga[rota_cauda] + carga[rota_cabeca] > capacidade)
+        {
+            continue;
+        }
+        int ajuste_cauda = ajustePonta(juncao.cauda, juncao.sentido_cauda, true);
+        int ajuste_cabeca = ajustePonta(juncao.cabeca, juncao.sentido_cabeca, false);
+        if (ajuste_cauda < 0 || ajuste_cabeca < 0)
+        {
+            continue;
+        }
+
+        if (ajuste_cauda)
+        {
+            inverterRota(rota_cauda);
+        }
+        if (ajuste_cabeca)
+        {
+            inverterRota(rota_cabeca);
+        }
+        sentido[juncao.cauda] = juncao.sentido_cauda;
+        sentido[juncao.cabeca] = juncao.sentido_cabeca;
+
+        proximo[juncao.cauda] = juncao.cabeca;
+        anterior[juncao.cabeca] = juncao.cauda;
+
+        // A rota menor passa a ter o id da maior: cada serviço muda de rota
+        // O(log S) vezes
+        int rota = rota_cauda, absorvida = rota_cabeca;
+        if (tamanho[rota] < tamanho[absorvida])
+        {
+            swap(rota, absorvida);
+        }
+        for (int id = primeiro[absorvida];; id = proximo[id])
+        {
+            rota_de[id] = rota;
+            if (id == ultimo[absorvida])
+            {
+                break;
+            }
+        }
+        int novo_primeiro = primeiro[rota_cauda], novo_ultimo = ultimo[rota_cabeca];
+        primeiro[rota] = novo_primeiro;
+        ultimo[rota] = novo_ultimo;
+        carga[rota] += carga[absorvida];
+        tamanho[rota] += tamanho[absorvida];
+        invertivel[rota] = invertivel[rota] && invertivel[absorvida];
+        juncoes++;
+    }
+
+    // Rotas na ordem do menor id do seu primeiro serviço
+    Solucao solucao;
+    vector<ServicoOrientado> visitas;
+    for (int id = 1; id <= num_servicos; id++)
+    {
+        if (primeiro[rota_de[id]] != id)
+        {
+            continue;
+        }
+        visitas.clear();
+        for (int atual = id; atual != 0; atual = proximo[atual])
+        {
+            const Servico &servico = servicos[atual - 1];
+            visitas.push_back({atual, entradaNoSentido(servico, sentido[atual]),
+                               saidaNoSentido(servico, sentido[atual])});
+        }
+        solucao.rotas.push_back(montarRota(grafo, visitas));
+        solucao.custo_total += solucao.rotas.back().custo_total;
+    }
+    solucao.num_rotas = solucao.rotas.size();
+    solucao.tempo_execucao = clock() - inicio;
+
+    REGISTRO_DEPURACAO("Economias: " << juncoes << " junções, " << solucao.num_rotas << " rotas e custo "
+                       << solucao.custo_total);
+
+    return solucao;
+}
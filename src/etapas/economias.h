@@ -0,0 +1,19 @@
+#ifndef ECONOMIAS_H
+#define ECONOMIAS_H
+
+#include "etapa2.h"
+
+using namespace std;
+
+// Construção por economias (Clarke e Wright) para serviços em nós, arcos e
+// arestas. Parte de uma rota por serviço e junta rotas pelo fim de uma e o
+// começo da outra, na ordem decrescente da economia
+//     d(saída de i, depósito) + d(depósito, entrada de j) - d(saída de i, entrada de j)
+// calculada para cada par de serviços e cada sentido das arestas. As economias
+// saem de um heap e são descartadas se i já não for o fim da sua rota (no
+// sentido considerado, admitindo inverter rotas só de arestas e nós), se j já
+// não for o começo da sua, se forem a mesma rota ou se a carga somada passar da
+// capacidade; todas essas verificações são O(1). Custo O(S² log S) no pior caso.
+Solucao solucaoEconomias(const Grafo &grafo, clock_t &inicio_execucao);
+
+#endif // ECONOMIAS_H
@@ -1,100 +1,85 @@
 #include "etapa1.h"
+#include "../core/registro.h"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <atomic>
 
 namespace fs = std::filesystem;
 
-void executarEtapa1()
+bool executarEtapa1(const OpcoesLote &opcoes)
 {
-    cout << "Iniciando Etapa 1 - Análise de Métricas dos Grafos" << endl;
+    REGISTRO_INFO("Iniciando Etapa 1 - Análise de Métricas dos Grafos");
+    REGISTRO_INFO("Buscando arquivos .dat em: " << opcoes.entrada);
 
-    string diretorio_dados = "./dados/";
-    vector<MetricasGrafo> resultados;
-
-    cout << "Buscando arquivos .dat em: " << diretorio_dados << endl;
-
-    if (!fs::exists(diretorio_dados))
+    vector<string> instancias = listarInstancias(opcoes.entrada);
+    int total_arquivos = instancias.size();
+    if (total_arquivos == 0)
     {
-        cerr << "Erro: Diretório de dados não encontrado: " << diretorio_dados << endl;
-        cerr << "Certifique-se de que o diretório existe e contém arquivos .dat" << endl;
-        return;
+        REGISTRO_ERRO("Nenhum arquivo .dat encontrado para: " << opcoes.entrada);
+        return false;
     }
 
-    int total_arquivos = 0;
-    int arquivos_processados = 0;
+    REGISTRO_INFO("Total de arquivos a processar: " << total_arquivos);
 
-    // Contar arquivos primeiro
-    for (const auto &entrada : fs::directory_iterator(diretorio_dados))
-    {
-        if (entrada.is_regular_file() && entrada.path().extension() == ".dat")
-        {
-            // Pular arquivos de solução
-            if (entrada.path().filename().string().substr(0, 4) != "sol-")
-            {
-                total_arquivos++;
-            }
-        }
-    }
+    // Um resultado por instância, na ordem de nome, qualquer que seja a ordem de término
+    vector<MetricasGrafo> metricas(total_arquivos);
+    vector<char> processado(total_arquivos, 0);
+    atomic<int> arquivos_processados(0);
 
-    if (total_arquivos == 0)
+    processarInstancias(instancias, 1, opcoes.num_jobs, [&](size_t i)
     {
-        cerr << "Nenhum arquivo .dat encontrado no diretório: " << diretorio_dados << endl;
-        return;
-    }
+        string nome_arquivo = fs::path(instancias[i]).filename().string();
+        REGISTRO_INFO("\n[" << ++arquivos_processados << "/" << total_arquivos << "] Processando: " << nome_arquivo);
 
-    cout << "Total de arquivos a processar: " << total_arquivos << endl;
+        try
+        {
+            metricas[i] = processarArquivoGrafo(instancias[i]);
+            processado[i] = 1;
+            REGISTRO_INFO("✓ Processado com sucesso: " << nome_arquivo);
+        }
+        catch (const exception &e)
+        {
+            REGISTRO_ERRO("✗ Erro ao processar " << nome_arquivo << ": " << e.what());
+        }
+    });
 
-    // Processar cada arquivo .dat no diretório
-    for (const auto &entrada : fs::directory_iterator(diretorio_dados))
+    vector<MetricasGrafo> resultados;
+    for (int i = 0; i < total_arquivos; i++)
     {
-        if (entrada.is_regular_file() && entrada.path().extension() == ".dat")
+        if (processado[i])
         {
-            string nome_arquivo = entrada.path().filename().string();
-
-            // Pular arquivos de solução
-            if (nome_arquivo.substr(0, 4) == "sol-")
-            {
-                continue;
-            }
-
-            arquivos_processados++;
-            cout << "\n[" << arquivos_processados << "/" << total_arquivos << "] Processando: " << nome_arquivo << endl;
-
-            try
-            {
-                resultados.push_back(processarArquivoGrafo(entrada.path().string()));
-                cout << "✓ Processado com sucesso!" << endl;
-            }
-            catch (const exception &e)
-            {
-                cerr << "✗ Erro ao processar " << nome_arquivo << ": " << e.what() << endl;
-            }
+            resultados.push_back(move(metricas[i]));
         }
     }
 
     if (resultados.empty())
     {
-        cerr << "Nenhum arquivo foi processado com sucesso!" << endl;
-        return;
+        REGISTRO_ERRO("Nenhum arquivo foi processado com sucesso!");
+        return false;
     }
 
     // Exportar resultados
-    cout << "\nExportando resultados..." << endl;
-    exportarParaCSV(resultados, "resultados_metricas_grafos.csv");
-
-    cout << "\n=== ETAPA 1 CONCLUÍDA ===" << endl;
-    cout << "Arquivos processados: " << resultados.size() << "/" << total_arquivos << endl;
-    cout << "Resultados exportados para:" << endl;
-    cout << "- resultados_metricas_grafos.csv" << endl;
-    cout << "- resultados_intermediacao.csv" << endl;
+    REGISTRO_INFO("\nExportando resultados...");
+    exportarParaCSV(resultados, opcoes.diretorio_resultados);
+
+    REGISTRO_INFO("\n=== ETAPA 1 CONCLUÍDA ===");
+    REGISTRO_INFO("Arquivos processados: " << resultados.size() << "/" << total_arquivos);
+    REGISTRO_INFO("Resultados exportados para:");
+    REGISTRO_INFO("- " << (fs::path(opcoes.diretorio_resultados) / "resultados_metricas_grafos.csv").string());
+    REGISTRO_INFO("- " << (fs::path(opcoes.diretorio_resultados) / "resultados_intermediacao.csv").string());
+    return static_cast<int>(resultados.size()) == total_arquivos;
 }
 
 MetricasGrafo processarArquivoGrafo(const string &caminho_arquivo)
 {
     Grafo grafo;
     grafo.lerArquivoDados(caminho_arquivo);
+    return calcularMetricasGrafo(grafo);
+}
 
+MetricasGrafo calcularMetricasGrafo(const Grafo &grafo)
+{
     MetricasGrafo metricas;
 
     // Salva as estatísticas do grafo
@@ -105,18 +90,37 @@ MetricasGrafo processarArquivoGrafo(const string &caminho_arquivo)
     metricas.num_vertices_obrigatorios = grafo.getNumRequiredVertices();
     metricas.num_arestas_obrigatorias = grafo.getNumRequiredEdges();
     metricas.num_arcos_obrigatorios = grafo.getNumRequiredArcs();
-    metricas.densidade = grafo.calcularDensidade();
-    metricas.grau_minimo = grafo.grausMinimo();
-    metricas.grau_maximo = grafo.grausMaximo();
-    metricas.caminho_medio = grafo.calcularCaminhoMedio();
-    metricas.diametro = grafo.calcularDiametro();
-    metricas.intermediacao = grafo.calcularIntermediacao();
+
+    // Todas as métricas em uma única varredura sobre os caminhos já calculados
+    ResumoMetricas resumo = grafo.calcularMetricas();
+    metricas.densidade = resumo.densidade;
+    metricas.grau_minimo = resumo.grau_minimo;
+    metricas.grau_maximo = resumo.grau_maximo;
+    metricas.caminho_medio = resumo.caminho_medio;
+    metricas.diametro = resumo.diametro;
+    metricas.intermediacao = move(resumo.intermediacao);
+
+    if (resumo.amostras_intermediacao > 0)
+    {
+        REGISTRO_INFO("Intermediação amostrada: " << resumo.amostras_intermediacao << "/" << resumo.amostras_previstas
+                      << " pares, erro <= " << resumo.erro_intermediacao * metricas.num_vertices * (metricas.num_vertices - 1.0)
+                      << " (" << resumo.erro_intermediacao << " normalizado) com probabilidade "
+                      << 1 - Grafo::obterParametrosAmostragem().delta);
+        if (resumo.amostras_intermediacao < resumo.amostras_previstas)
+        {
+            REGISTRO_AVISO("Aviso: tempo limite atingido antes do epsilon pedido");
+        }
+    }
 
     return metricas;
 }
 
-void exportarParaCSV(const vector<MetricasGrafo> &todas_metricas, const string &arquivo_saida)
+void exportarParaCSV(const vector<MetricasGrafo> &todas_metricas, const string &diretorio_resultados)
 {
+    fs::create_directories(diretorio_resultados);
+    string arquivo_saida = (fs::path(diretorio_resultados) / "resultados_metricas_grafos.csv").string();
+    string arquivo_saida_intermediacao = (fs::path(diretorio_resultados) / "resultados_intermediacao.csv").string();
+
     ofstream arquivo_csv(arquivo_saida);
 
     if (!arquivo_csv.is_open())
@@ -147,11 +151,11 @@ void exportarParaCSV(const vector<MetricasGrafo> &todas_metricas, const string &
     arquivo_csv.close();
 
     // Exportar a centralidade de intermediação separadamente
-    ofstream arquivo_intermediacao("resultados_intermediacao.csv");
+    ofstream arquivo_intermediacao(arquivo_saida_intermediacao);
 
     if (!arquivo_intermediacao.is_open())
     {
-        throw runtime_error("Não foi possível criar o arquivo: resultados_intermediacao.csv");
+        throw runtime_error("Não foi possível criar o arquivo: " + arquivo_saida_intermediacao);
     }
 
     // Cabeçalho
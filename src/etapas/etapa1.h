@@ -2,6 +2,7 @@
 #define ETAPA1_H
 
 #include "../core/grafo.h"
+#include "lote.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -26,11 +27,12 @@ struct MetricasGrafo
     map<int, double> intermediacao;
 };
 
-// Função principal da Etapa 1
-void executarEtapa1();
+// Função principal da Etapa 1; true se todas as instâncias foram processadas
+bool executarEtapa1(const OpcoesLote &opcoes = OpcoesLote());
 
 // Funções auxiliares
 MetricasGrafo processarArquivoGrafo(const string &caminho_arquivo);
-void exportarParaCSV(const vector<MetricasGrafo> &todas_metricas, const string &arquivo_saida);
+MetricasGrafo calcularMetricasGrafo(const Grafo &grafo); // Grafo lido no modo COMPLETA
+void exportarParaCSV(const vector<MetricasGrafo> &todas_metricas, const string &diretorio_resultados);
 
 #endif // ETAPA1_H
\ No newline at end of file
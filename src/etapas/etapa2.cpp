@@ -1,9 +1,19 @@
 #include "etapa2.h"
+#include "divisao.h"
+#include "economias.h"
+#include "busca_local.h"
+#include "../core/registro.h"
+#include "../core/dijkstra.h"
+#include "../core/paralelo.h"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <atomic>
 #include <algorithm>
+#include <numeric>
 #include <limits>
+#include <random>
+#include <chrono>
 
 namespace fs = std::filesystem;
 
@@ -20,373 +30,793 @@ Solucao::Solucao()
     tempo_execucao = 0;
 }
 
-void executarEtapa2()
+bool executarEtapa2(const OpcoesLote &opcoes)
 {
-    cout << "Iniciando Etapa 2 - Geração de Soluções Iniciais" << endl;
+    REGISTRO_INFO("Iniciando Etapa 2 - Geração de Soluções Iniciais");
 
-    string diretorio_dados = "./dados/";
-    string diretorio_saida = "./solucao/";
+    string diretorio_saida = (fs::path(opcoes.diretorio_saida.empty() ? "./solucao/" : opcoes.diretorio_saida) / "").string();
     clock_t inicio = clock();
 
     // Criar o diretório de saída se não existir
     if (!fs::exists(diretorio_saida))
     {
         fs::create_directories(diretorio_saida);
-        cout << "Diretório de saída criado: " << diretorio_saida << endl;
+        REGISTRO_INFO("Diretório de saída criado: " << diretorio_saida);
     }
 
-    if (!fs::exists(diretorio_dados))
+    REGISTRO_INFO("Buscando arquivos .dat em: " << opcoes.entrada);
+    REGISTRO_INFO("Salvando soluções em: " << diretorio_saida);
+
+    vector<string> instancias = listarInstancias(opcoes.entrada);
+    int total_instancias = instancias.size();
+    if (total_instancias == 0)
     {
-        cerr << "Erro: Diretório de dados não encontrado: " << diretorio_dados << endl;
-        return;
+        REGISTRO_ERRO("Nenhum arquivo .dat encontrado para: " << opcoes.entrada);
+        return false;
     }
 
-    cout << "Buscando arquivos .dat em: " << diretorio_dados << endl;
-    cout << "Salvando soluções em: " << diretorio_saida << endl;
+    REGISTRO_INFO("Total de instâncias a processar: " << total_instancias);
 
-    int total_instancias = 0;
-    int instancias_processadas = 0;
-    int instancias_sucesso = 0;
+    atomic<int> instancias_iniciadas(0);
+    atomic<int> instancias_processadas(0);
+    atomic<int> instancias_sucesso(0);
 
-    // Contar o número total de instâncias para processar
-    for (const auto &entrada : fs::directory_iterator(diretorio_dados))
+    processarInstancias(instancias, 2, opcoes.num_jobs, [&](size_t i)
     {
-        if (entrada.is_regular_file() && entrada.path().extension() == ".dat")
+        string caminho_arquivo = instancias[i];
+        string nome_arquivo = fs::path(caminho_arquivo).filename().string();
+
+        REGISTRO_INFO("\n===================================================");
+        REGISTRO_INFO("Processando instância " << ++instancias_iniciadas << "/" << total_instancias
+                      << ": " << nome_arquivo);
+        REGISTRO_INFO("===================================================");
+
+        try
         {
-            if (entrada.path().filename().string().substr(0, 4) != "sol-")
-            {
-                total_instancias++;
-            }
+            // Ler o grafo (só as distâncias entre extremidades de serviços e depósito são usadas)
+            Grafo grafo;
+            grafo.lerArquivoDados(caminho_arquivo, ModoDistancias::TERMINAIS);
+
+            // Gerar solução inicial
+            Solucao solucao = construirSolucao(grafo, inicio, opcoes.grasp);
+
+            // Salvar solução
+            salvarSolucao(nome_arquivo, solucao, diretorio_saida, grafo);
+
+            REGISTRO_INFO("\n✓ Resumo da solução para " << nome_arquivo << ":");
+            REGISTRO_INFO("Custo total: " << solucao.custo_total);
+            REGISTRO_INFO("Número de rotas: " << solucao.num_rotas);
+            REGISTRO_INFO("Tempo de execução: " << solucao.tempo_execucao << " clocks");
+
+            instancias_sucesso++;
+        }
+        catch (const exception &e)
+        {
+            REGISTRO_ERRO("✗ Erro ao processar instância " << nome_arquivo << ": " << e.what());
         }
+
+        int concluidas = ++instancias_processadas;
+        REGISTRO_INFO("---------------------------------------------------");
+        REGISTRO_INFO("Progresso: " << concluidas << "/" << total_instancias
+                      << " (" << (concluidas * 100 / total_instancias) << "%)");
+    });
+
+    REGISTRO_INFO("\n=== ETAPA 2 CONCLUÍDA ===");
+    REGISTRO_INFO("Total processado: " << instancias_sucesso << "/" << total_instancias);
+    REGISTRO_INFO("Soluções salvas em: " << diretorio_saida);
+    return instancias_sucesso == total_instancias;
+}
+
+// Serviço visto a partir de um vértice: custo de chegada e extremidade por onde é iniciado
+struct CandidatoServico
+{
+    Custo custo;
+    int id_servico;
+    int no_entrada;
+};
+
+static CandidatoServico avaliarServico(const Grafo &grafo, const Servico &servico, int id_servico, int no)
+{
+    Custo custo_para_origem = grafo.getDistancia(no, servico.origem);
+    if (servico.tipo != 'E')
+    {
+        // Nó e arco requeridos são iniciados pela origem
+        return {custo_para_origem, id_servico, servico.origem};
     }
 
-    if (total_instancias == 0)
+    // Aresta: entra pela extremidade mais próxima (origem no empate)
+    Custo custo_para_destino = grafo.getDistancia(no, servico.destino);
+    if (custo_para_origem <= custo_para_destino)
     {
-        cerr << "Nenhum arquivo .dat encontrado no diretório: " << diretorio_dados << endl;
-        return;
+        return {custo_para_origem, id_servico, servico.origem};
     }
+    return {custo_para_destino, id_servico, servico.destino};
+}
 
-    cout << "Total de instâncias a processar: " << total_instancias << endl;
+int noDeSaida(const Servico &servico, int no_entrada)
+{
+    if (servico.tipo == 'N')
+    {
+        return servico.origem;
+    }
+    if (servico.tipo == 'A')
+    {
+        return servico.destino;
+    }
+    return (no_entrada == servico.origem) ? servico.destino : servico.origem;
+}
 
-    // Processar cada arquivo .dat no diretório
-    for (const auto &entrada : fs::directory_iterator(diretorio_dados))
+// Candidatos do guloso indexados pela extremidade de entrada: para cada vértice,
+// os serviços que podem começar nele (origem de nós e arcos, as duas pontas das
+// arestas), mais o conjunto dos ainda pendentes com pertinência e remoção O(1).
+class CandidatosPorEntrada
+{
+private:
+    vector<int> inicio;   // inicio[v]..inicio[v+1] em ids (como na adjacência CSR)
+    vector<int> ids;
+    vector<char> pendente;
+    size_t num_pendentes;
+    const vector<Servico> &servicos;
+    vector<int> por_demanda;       // Ids em ordem crescente de demanda
+    mutable size_t menor_pendente; // Posição em por_demanda do primeiro ainda pendente
+
+public:
+    explicit CandidatosPorEntrada(const Grafo &grafo)
+        : inicio(grafo.getNumVertices() + 2, 0), pendente(grafo.getServicos().size() + 1, 1),
+          num_pendentes(grafo.getServicos().size()), servicos(grafo.getServicos()),
+          por_demanda(grafo.getServicos().size()), menor_pendente(0)
     {
-        if (entrada.is_regular_file() && entrada.path().extension() == ".dat")
+        auto paraCadaEntrada = [&](auto &&registrar)
         {
-            string caminho_arquivo = entrada.path().string();
-            string nome_arquivo = entrada.path().filename().string();
-
-            // Pular arquivos de solução
-            if (nome_arquivo.substr(0, 4) == "sol-")
+            for (size_t i = 0; i < servicos.size(); i++)
             {
-                continue;
+                registrar(servicos[i].origem, i + 1);
+                if (servicos[i].tipo == 'E' && servicos[i].destino != servicos[i].origem)
+                {
+                    registrar(servicos[i].destino, i + 1);
+                }
             }
+        };
 
-            instancias_processadas++;
-            cout << "\n===================================================" << endl;
-            cout << "Processando instância " << instancias_processadas << "/" << total_instancias
-                 << ": " << nome_arquivo << endl;
-            cout << "===================================================" << endl;
+        paraCadaEntrada([&](int v, int) { inicio[v + 1]++; });
+        for (size_t v = 1; v < inicio.size(); v++)
+        {
+            inicio[v] += inicio[v - 1];
+        }
+        ids.resize(inicio.back());
+        vector<int> proximo(inicio.begin(), inicio.end() - 1);
+        paraCadaEntrada([&](int v, int id_servico) { ids[proximo[v]++] = id_servico; });
+        pendente[0] = 0;
+
+        iota(por_demanda.begin(), por_demanda.end(), 1);
+        stable_sort(por_demanda.begin(), por_demanda.end(),
+                    [&](int a, int b) { return servicos[a - 1].demanda < servicos[b - 1].demanda; });
+    }
 
-            try
-            {
-                // Ler o grafo
-                Grafo grafo;
-                grafo.lerArquivoDados(caminho_arquivo);
+    bool contem(int id_servico) const { return pendente[id_servico]; }
+    bool vazio() const { return num_pendentes == 0; }
+    size_t tamanho() const { return num_pendentes; }
 
-                // Gerar solução inicial
-                Solucao solucao = solucaoInicial(grafo, inicio);
+    // Todos os serviços pendentes de novo (reaproveita o índice entre construções)
+    void restaurar()
+    {
+        fill(pendente.begin() + 1, pendente.end(), 1);
+        num_pendentes = servicos.size();
+        menor_pendente = 0;
+    }
 
-                // Salvar solução
-                salvarSolucao(nome_arquivo, solucao, diretorio_saida, grafo);
+    void remover(int id_servico)
+    {
+        pendente[id_servico] = 0;
+        num_pendentes--;
+    }
 
-                cout << "\n✓ Resumo da solução para " << nome_arquivo << ":" << endl;
-                cout << "Custo total: " << solucao.custo_total << endl;
-                cout << "Número de rotas: " << solucao.num_rotas << endl;
-                cout << "Tempo de execução: " << solucao.tempo_execucao << " clocks" << endl;
+    // Menor demanda entre os pendentes (os removidos do início são pulados uma única vez)
+    int menorDemanda() const
+    {
+        while (menor_pendente < por_demanda.size() && !pendente[por_demanda[menor_pendente]])
+        {
+            menor_pendente++;
+        }
+        return menor_pendente < por_demanda.size() ? servicos[por_demanda[menor_pendente] - 1].demanda
+                                                   : numeric_limits<int>::max();
+    }
 
-                instancias_sucesso++;
-            }
-            catch (const exception &e)
+    const int *begin(int v) const { return ids.data() + inicio[v]; }
+    const int *end(int v) const { return ids.data() + inicio[v + 1]; }
+};
+
+// Serviço pendente de menor custo a partir de no_atual (no empate, o de menor id)
+// cuja demanda cabe em capacidade_livre. id_servico = -1 se nenhum for alcançável.
+//
+// Em vez de avaliar todos os pendentes, a busca percorre os vértices em ordem
+// de distância a partir de no_atual e para na primeira distância em que houver
+// um pendente que caiba (depois de ver todos os vértices empatados nela). As
+// distâncias são as mesmas das tabelas do Grafo, então a escolha é idêntica à
+// da varredura completa, mas o custo é o da vizinhança explorada.
+static CandidatoServico escolherServico(const Grafo &grafo, BuscaIncremental &busca,
+                                        const CandidatosPorEntrada &candidatos, int no_atual, int capacidade_livre)
+{
+    const vector<Servico> &servicos = grafo.getServicos();
+    int melhor_servico = -1;
+    Custo distancia_melhor = CUSTO_INFINITO;
+
+    // Nenhum pendente cabe: não há o que procurar
+    if (candidatos.menorDemanda() > capacidade_livre)
+    {
+        return {CUSTO_INFINITO, -1, -1};
+    }
+
+    busca.percorrer(no_atual, [&](int v, Custo distancia)
+    {
+        if (melhor_servico != -1 && distancia > distancia_melhor)
+        {
+            return false;
+        }
+        for (const int *id = candidatos.begin(v); id != candidatos.end(v); id++)
+        {
+            if (candidatos.contem(*id) && servicos[*id - 1].demanda <= capacidade_livre &&
+                (melhor_servico == -1 || *id < melhor_servico))
             {
-                cerr << "✗ Erro ao processar instância " << nome_arquivo << ": " << e.what() << endl;
+                melhor_servico = *id;
+                distancia_melhor = distancia;
             }
-
-            cout << "---------------------------------------------------" << endl;
-            cout << "Progresso: " << instancias_processadas << "/" << total_instancias
-                 << " (" << (instancias_processadas * 100 / total_instancias) << "%)" << endl;
         }
+        return true;
+    });
+
+    if (melhor_servico == -1)
+    {
+        return {CUSTO_INFINITO, -1, -1};
     }
 
-    cout << "\n=== ETAPA 2 CONCLUÍDA ===" << endl;
-    cout << "Total processado: " << instancias_sucesso << "/" << total_instancias << endl;
-    cout << "Soluções salvas em: " << diretorio_saida << endl;
+    // Extremidade de entrada (e custo) pela mesma regra da varredura completa
+    return avaliarServico(grafo, servicos[melhor_servico - 1], melhor_servico, no_atual);
 }
 
-Solucao solucaoInicial(const Grafo &grafo, clock_t &inicio_execucao)
+// Serviço pendente sorteado na lista restrita de candidatos do GRASP: os que
+// cabem em capacidade_livre e estão a no máximo (1 + alfa) vezes a distância
+// do mais próximo, limitados aos tamanho_lrc mais próximos. O limite relativo
+// ao mais próximo (em vez de min + alfa * (max - min)) dispensa conhecer o mais
+// distante, e a lista sai da mesma busca em ordem de distância de
+// escolherServico. Com alfa = 0 só se sorteia entre os empatados, que o guloso
+// desempata pelo id. id_servico = -1 se nenhum couber.
+static CandidatoServico sortearServico(const Grafo &grafo, BuscaIncremental &busca,
+                                       const CandidatosPorEntrada &candidatos, int no_atual, int capacidade_livre,
+                                       size_t tamanho_lrc, double alfa, mt19937_64 &gerador,
+                                       vector<CandidatoServico> &lrc)
 {
-    Solucao solucao;
-    clock_t inicio = inicio_execucao;
+    const vector<Servico> &servicos = grafo.getServicos();
+    lrc.clear();
 
-    cout << "Iniciando construção da solução inicial..." << endl;
+    if (candidatos.menorDemanda() > capacidade_livre)
+    {
+        return {CUSTO_INFINITO, -1, -1};
+    }
 
-    int deposito = grafo.getDeposito();
-    const vector<Servico> &servicos = grafo.getServicos();
+    busca.percorrer(no_atual, [&](int v, Custo distancia)
+    {
+        // Os vértices chegam em distância crescente: lrc.back() é o mais distante
+        if (!lrc.empty() && (distancia > lrc.front().custo * (1 + alfa) ||
+                             (lrc.size() >= tamanho_lrc && distancia > lrc.back().custo)))
+        {
+            return false;
+        }
+        for (const int *id = candidatos.begin(v); id != candidatos.end(v); id++)
+        {
+            // Arestas aparecem nas duas pontas; vale a primeira (a mais próxima)
+            if (candidatos.contem(*id) && servicos[*id - 1].demanda <= capacidade_livre &&
+                none_of(lrc.begin(), lrc.end(), [&](const CandidatoServico &c) { return c.id_servico == *id; }))
+            {
+                lrc.push_back({distancia, *id, v});
+            }
+        }
+        return true;
+    });
 
-    cout << "Total de serviços: " << servicos.size() << endl;
-    cout << "Capacidade do veículo: " << grafo.getCapacidade() << endl;
+    if (lrc.empty())
+    {
+        return {CUSTO_INFINITO, -1, -1};
+    }
 
-    // Lista de todos os serviços não atribuídos
-    vector<int> servicos_nao_atribuidos;
-    for (size_t i = 0; i < servicos.size(); i++)
+    // Empates na fronteira são cortados pelo id, como no guloso
+    sort(lrc.begin(), lrc.end(), [](const CandidatoServico &a, const CandidatoServico &b)
+         { return a.custo != b.custo ? a.custo < b.custo : a.id_servico < b.id_servico; });
+    if (lrc.size() > tamanho_lrc)
     {
-        servicos_nao_atribuidos.push_back(i + 1);
+        lrc.resize(tamanho_lrc);
     }
 
-    vector<Rota> rotas;
-    int contador_rotas = 0;
+    // Resto da divisão em vez de uniform_int_distribution, cuja saída muda
+    // entre bibliotecas padrão: a mesma semente dá a mesma solução em qualquer uma
+    int escolhido = lrc[gerador() % lrc.size()].id_servico;
+    return avaliarServico(grafo, servicos[escolhido - 1], escolhido, no_atual);
+}
 
-    // Criar rotas até que todos os serviços sejam atendidos
-    while (!servicos_nao_atribuidos.empty())
+// Regras de desempate da varredura de caminhos (path-scanning) entre os
+// serviços pendentes mais próximos, como em Golden, DeArmon e Baker (1983)
+enum class RegraVarredura
+{
+    MAIS_LONGE_DO_DEPOSITO, // Maior distância da saída do serviço ao depósito
+    MAIS_PERTO_DO_DEPOSITO, // Menor distância da saída do serviço ao depósito
+    MAIOR_RAZAO,            // Maior demanda / custo de serviço
+    MENOR_RAZAO,            // Menor demanda / custo de serviço
+    PELA_CARGA              // MAIS_LONGE com a rota até metade da capacidade, MAIS_PERTO depois
+};
+
+static const int NUM_REGRAS_VARREDURA = 5;
+
+// Próximo serviço da varredura: entre os pendentes que cabem em capacidade_livre
+// à menor distância de no_atual (todos os empatados, cada aresta por cada ponta
+// empatada), o melhor pela regra; persistindo o empate, o de menor id entrando
+// pela origem. id_servico = -1 se nenhum couber.
+static CandidatoServico varrerCaminho(const Grafo &grafo, BuscaIncremental &busca,
+                                      const CandidatosPorEntrada &candidatos, int no_atual, int capacidade_livre,
+                                      RegraVarredura regra, vector<CandidatoServico> &empatados)
+{
+    const vector<Servico> &servicos = grafo.getServicos();
+    int deposito = grafo.getDeposito();
+    empatados.clear();
+
+    if (candidatos.menorDemanda() > capacidade_livre)
     {
-        contador_rotas++;
-        cout << "Criando rota " << contador_rotas << " (serviços restantes: "
-             << servicos_nao_atribuidos.size() << ")" << endl;
+        return {CUSTO_INFINITO, -1, -1};
+    }
 
-        // Evitar loop infinito
-        if (contador_rotas > 100)
+    busca.percorrer(no_atual, [&](int v, Custo distancia)
+    {
+        if (!empatados.empty() && distancia > empatados.front().custo)
         {
-            cout << "AVISO: Muitas rotas criadas. Parando para evitar loop infinito." << endl;
-            break;
+            return false;
         }
-
-        // Encontrar o serviço mais próximo do depósito
-        int melhor_servico = -1;
-        int melhor_no = -1;
-        double menor_custo = numeric_limits<double>::infinity();
-
-        for (int id_servico : servicos_nao_atribuidos)
+        for (const int *id = candidatos.begin(v); id != candidatos.end(v); id++)
         {
-            const Servico &servico = servicos[id_servico - 1];
+            if (candidatos.contem(*id) && servicos[*id - 1].demanda <= capacidade_livre)
+            {
+                empatados.push_back({distancia, *id, v});
+            }
+        }
+        return true;
+    });
 
-            double custo_para_origem = grafo.getDistancia(deposito, servico.origem);
-            double custo_para_destino = grafo.getDistancia(deposito, servico.destino);
+    if (empatados.empty())
+    {
+        return {CUSTO_INFINITO, -1, -1};
+    }
 
-            double custo;
-            int no_entrada;
+    if (regra == RegraVarredura::PELA_CARGA)
+    {
+        // A rota vazia recebe capacidade_livre ilimitada: carga zero
+        long long carga = max(0LL, static_cast<long long>(grafo.getCapacidade()) - capacidade_livre);
+        regra = 2 * carga < grafo.getCapacidade() ? RegraVarredura::MAIS_LONGE_DO_DEPOSITO
+                                                  : RegraVarredura::MAIS_PERTO_DO_DEPOSITO;
+    }
 
-            if (servico.tipo == 'N')
-            {
-                custo = custo_para_origem;
-                no_entrada = servico.origem;
-            }
-            else if (servico.tipo == 'A')
-            {
-                custo = custo_para_origem;
-                no_entrada = servico.origem;
-            }
-            else // 'E'
+    // Comparação pela regra: > 0 se a for preferível a b, < 0 se b, 0 no empate
+    auto comparar = [&](const CandidatoServico &a, const CandidatoServico &b) -> long long
+    {
+        const Servico &servico_a = servicos[a.id_servico - 1];
+        const Servico &servico_b = servicos[b.id_servico - 1];
+        switch (regra)
+        {
+            case RegraVarredura::MAIS_LONGE_DO_DEPOSITO:
+            case RegraVarredura::MAIS_PERTO_DO_DEPOSITO:
             {
-                if (custo_para_origem <= custo_para_destino)
-                {
-                    custo = custo_para_origem;
-                    no_entrada = servico.origem;
-                }
-                else
-                {
-                    custo = custo_para_destino;
-                    no_entrada = servico.destino;
-                }
+                long long diferenca =
+                    static_cast<long long>(grafo.getDistancia(noDeSaida(servico_a, a.no_entrada), deposito)) -
+                    grafo.getDistancia(noDeSaida(servico_b, b.no_entrada), deposito);
+                return regra == RegraVarredura::MAIS_LONGE_DO_DEPOSITO ? diferenca : -diferenca;
             }
-
-            if (custo < menor_custo)
+            default:
             {
-                menor_custo = custo;
-                melhor_servico = id_servico;
-                melhor_no = no_entrada;
+                // Razões comparadas em produto cruzado (custo de serviço zero = razão infinita)
+                long long diferenca = static_cast<long long>(servico_a.demanda) * servico_b.custo_servico -
+                                      static_cast<long long>(servico_b.demanda) * servico_a.custo_servico;
+                return regra == RegraVarredura::MAIOR_RAZAO ? diferenca : -diferenca;
             }
         }
+    };
 
-        if (melhor_servico == -1)
+    const CandidatoServico *melhor = &empatados[0];
+    for (const CandidatoServico &candidato : empatados)
+    {
+        long long comparacao = comparar(candidato, *melhor);
+        if (comparacao > 0 ||
+            (comparacao == 0 && (candidato.id_servico < melhor->id_servico ||
+                                 (candidato.id_servico == melhor->id_servico &&
+                                  candidato.no_entrada == servicos[candidato.id_servico - 1].origem))))
         {
-            cout << "ERRO: Não foi possível encontrar um serviço válido!" << endl;
-            break;
+            melhor = &candidato;
         }
+    }
+    return *melhor;
+}
 
-        // Criar nova rota começando com o melhor serviço
-        Rota rota;
-        const Servico &servico = servicos[melhor_servico - 1];
+// Monta as rotas tirando de servicos_nao_atribuidos o serviço indicado por
+// escolher(no_atual, capacidade_livre) até esvaziá-lo (deve chegar completo).
+template <typename Escolher>
+static Solucao construirRotas(const Grafo &grafo, CandidatosPorEntrada &servicos_nao_atribuidos,
+                              Escolher &&escolher, bool registrar_rotas)
+{
+    Solucao solucao;
+    int deposito = grafo.getDeposito();
+    const vector<Servico> &servicos = grafo.getServicos();
 
-        rota.nos.push_back({melhor_servico, melhor_no});
-        rota.demanda_total = servico.demanda;
-        rota.custo_total = grafo.getDistancia(deposito, melhor_no) + servico.custo_servico;
+    vector<Rota> rotas;
+    int contador_rotas = 0;
 
-        // Determinar nó atual após executar o serviço
-        int no_atual;
-        if (servico.tipo == 'N')
-        {
-            no_atual = servico.origem;
-        }
-        else if (servico.tipo == 'A')
+    // Criar rotas até que todos os serviços sejam atendidos
+    while (!servicos_nao_atribuidos.vazio())
+    {
+        contador_rotas++;
+        if (registrar_rotas)
         {
-            no_atual = servico.destino;
+            REGISTRO_RASTRO("Criando rota " << contador_rotas << " (serviços restantes: "
+                            << servicos_nao_atribuidos.tamanho() << ")");
         }
-        else // 'E'
+
+        // Evitar loop infinito
+        if (contador_rotas > 100)
         {
-            no_atual = (melhor_no == servico.origem) ? servico.destino : servico.origem;
+            REGISTRO_AVISO("AVISO: Muitas rotas criadas. Parando para evitar loop infinito.");
+            break;
         }
 
-        // Remover serviço da lista
-        auto it = find(servicos_nao_atribuidos.begin(), servicos_nao_atribuidos.end(), melhor_servico);
-        if (it != servicos_nao_atribuidos.end())
+        // Encontrar o serviço mais próximo do depósito (a rota vazia aceita qualquer demanda)
+        CandidatoServico escolhido = escolher(deposito, numeric_limits<int>::max());
+
+        if (escolhido.id_servico == -1)
         {
-            servicos_nao_atribuidos.erase(it);
+            REGISTRO_ERRO("ERRO: Não foi possível encontrar um serviço válido!");
+            break;
         }
 
+        // Criar nova rota começando com o melhor serviço
+        Rota rota;
+        const Servico &servico = servicos[escolhido.id_servico - 1];
+
+        rota.nos.push_back({escolhido.id_servico, escolhido.no_entrada});
+        rota.demanda_total = servico.demanda;
+        rota.custo_total = grafo.getDistancia(deposito, escolhido.no_entrada) + servico.custo_servico;
+
+        // Determinar nó atual após executar o serviço
+        int no_atual = noDeSaida(servico, escolhido.no_entrada);
+        servicos_nao_atribuidos.remover(escolhido.id_servico);
+
         // Continuar adicionando serviços à rota atual
-        bool adicionou_servico = true;
         int tentativas = 0;
 
-        while (adicionou_servico && !servicos_nao_atribuidos.empty() &&
-               rota.demanda_total < grafo.getCapacidade())
+        while (!servicos_nao_atribuidos.vazio() && rota.demanda_total < grafo.getCapacidade())
         {
             tentativas++;
             if (tentativas > 500)
             {
-                cout << "AVISO: Muitas tentativas na rota atual. Finalizando rota." << endl;
+                REGISTRO_AVISO("AVISO: Muitas tentativas na rota atual. Finalizando rota.");
                 break;
             }
 
-            adicionou_servico = false;
-            melhor_servico = -1;
-            melhor_no = -1;
-            menor_custo = numeric_limits<double>::infinity();
-
-            for (int id_servico : servicos_nao_atribuidos)
+            escolhido = escolher(no_atual, grafo.getCapacidade() - rota.demanda_total);
+            if (escolhido.id_servico == -1)
             {
-                const Servico &servico = servicos[id_servico - 1];
-
-                // Verificar capacidade
-                if (rota.demanda_total + servico.demanda > grafo.getCapacidade())
-                    continue;
-
-                double custo_para_origem = grafo.getDistancia(no_atual, servico.origem);
-                double custo_para_destino = grafo.getDistancia(no_atual, servico.destino);
-
-                double custo;
-                int no_entrada;
-
-                if (servico.tipo == 'N')
-                {
-                    custo = custo_para_origem;
-                    no_entrada = servico.origem;
-                }
-                else if (servico.tipo == 'A')
-                {
-                    custo = custo_para_origem;
-                    no_entrada = servico.origem;
-                }
-                else // 'E'
-                {
-                    if (custo_para_origem <= custo_para_destino)
-                    {
-                        custo = custo_para_origem;
-                        no_entrada = servico.origem;
-                    }
-                    else
-                    {
-                        custo = custo_para_destino;
-                        no_entrada = servico.destino;
-                    }
-                }
-
-                if (custo < menor_custo)
-                {
-                    menor_custo = custo;
-                    melhor_servico = id_servico;
-                    melhor_no = no_entrada;
-                }
+                break;
             }
 
-            if (melhor_servico != -1)
-            {
-                const Servico &servico = servicos[melhor_servico - 1];
+            const Servico &proximo = servicos[escolhido.id_servico - 1];
 
-                rota.custo_total += grafo.getDistancia(no_atual, melhor_no);
-                rota.nos.push_back({melhor_servico, melhor_no});
-                rota.demanda_total += servico.demanda;
-                rota.custo_total += servico.custo_servico;
+            rota.custo_total += escolhido.custo;
+            rota.nos.push_back({escolhido.id_servico, escolhido.no_entrada});
+            rota.demanda_total += proximo.demanda;
+            rota.custo_total += proximo.custo_servico;
 
-                // Atualizar nó atual
-                if (servico.tipo == 'N')
-                {
-                    no_atual = servico.origem;
-                }
-                else if (servico.tipo == 'A')
-                {
-                    no_atual = servico.destino;
-                }
-                else // 'E'
-                {
-                    no_atual = (melhor_no == servico.origem) ? servico.destino : servico.origem;
-                }
-
-                // Remover serviço
-                auto it = find(servicos_nao_atribuidos.begin(), servicos_nao_atribuidos.end(), melhor_servico);
-                if (it != servicos_nao_atribuidos.end())
-                {
-                    servicos_nao_atribuidos.erase(it);
-                }
-
-                adicionou_servico = true;
-            }
+            // Atualizar nó atual e remover serviço
+            no_atual = noDeSaida(proximo, escolhido.no_entrada);
+            servicos_nao_atribuidos.remover(escolhido.id_servico);
         }
 
         // Adicionar custo de retorno ao depósito
         rota.custo_total += grafo.getDistancia(no_atual, deposito);
 
-        rotas.push_back(rota);
-
-        cout << "Rota " << contador_rotas << " criada: " << rota.nos.size()
-             << " serviços, demanda " << rota.demanda_total
-             << ", custo " << rota.custo_total << endl;
+        if (registrar_rotas)
+        {
+            REGISTRO_DEPURACAO("Rota " << contador_rotas << " criada: " << rota.nos.size()
+                               << " serviços, demanda " << rota.demanda_total
+                               << ", custo " << rota.custo_total);
+        }
+        rotas.push_back(move(rota));
     }
 
     // Finalizar solução
-    solucao.rotas = rotas;
-    solucao.num_rotas = rotas.size();
+    solucao.rotas = move(rotas);
+    solucao.num_rotas = solucao.rotas.size();
     solucao.custo_total = 0;
 
-    for (const auto &rota : rotas)
+    for (const auto &rota : solucao.rotas)
     {
         solucao.custo_total += rota.custo_total;
     }
+    return solucao;
+}
+
+// Ordem de todos os serviços, sem limite de capacidade (volta gigante), com o
+// próximo dado por escolher(no_atual). pendentes deve chegar completo.
+template <typename Escolher>
+static void montarVoltaGigante(const Grafo &grafo, CandidatosPorEntrada &pendentes, Escolher &&escolher,
+                               vector<ServicoOrientado> &volta)
+{
+    const vector<Servico> &servicos = grafo.getServicos();
+    int no_atual = grafo.getDeposito();
+    volta.clear();
+    while (!pendentes.vazio())
+    {
+        CandidatoServico escolhido = escolher(no_atual);
+        if (escolhido.id_servico == -1)
+        {
+            REGISTRO_ERRO("ERRO: Não foi possível encontrar um serviço válido!");
+            break;
+        }
+        no_atual = noDeSaida(servicos[escolhido.id_servico - 1], escolhido.no_entrada);
+        volta.push_back({escolhido.id_servico, escolhido.no_entrada, no_atual});
+        pendentes.remover(escolhido.id_servico);
+    }
+}
+
+Solucao solucaoInicial(const Grafo &grafo, clock_t &inicio_execucao)
+{
+    clock_t inicio = inicio_execucao;
+
+    REGISTRO_DEPURACAO("Iniciando construção da solução inicial...");
+    REGISTRO_DEPURACAO("Total de serviços: " << grafo.getServicos().size());
+    REGISTRO_DEPURACAO("Capacidade do veículo: " << grafo.getCapacidade());
+
+    // Todos os serviços começam não atribuídos
+    CandidatosPorEntrada servicos_nao_atribuidos(grafo);
+    BuscaIncremental busca(grafo.getAdjacencia());
+
+    Solucao solucao = construirRotas(grafo, servicos_nao_atribuidos, [&](int no_atual, int capacidade_livre)
+                                     { return escolherServico(grafo, busca, servicos_nao_atribuidos, no_atual,
+                                                              capacidade_livre); },
+                                     true);
 
     solucao.tempo_execucao = clock() - inicio;
 
-    cout << "Solução construída com " << solucao.num_rotas << " rotas e custo " << solucao.custo_total << endl;
+    REGISTRO_DEPURACAO("Solução construída com " << solucao.num_rotas << " rotas e custo " << solucao.custo_total);
 
     return solucao;
 }
 
-void salvarSolucao(const string &nome_arquivo, const Solucao &solucao, const string &diretorio_saida, const Grafo &grafo)
+// Semente da construção k (SplitMix64 sobre semente + k): a sequência sorteada
+// depende só da semente mestre e de k, não da thread que executa a construção
+static uint64_t sementeDaConstrucao(uint64_t semente, uint64_t k)
 {
-    string nome_solucao = "sol-" + nome_arquivo;
-    string caminho_solucao = diretorio_saida + nome_solucao;
+    uint64_t z = semente + (k + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
 
-    ofstream arquivo(caminho_solucao);
+// Construções do multipartida
+enum class TipoConstrucao
+{
+    GULOSO,
+    VARREDURA,           // Uma regra da varredura de caminhos
+    DIVISAO,             // Volta gigante do guloso dividida em rotas
+    ECONOMIAS,           // Clarke e Wright
+    GRASP,               // Guloso com sorteio na lista restrita de candidatos
+    VARREDURA_ALEATORIA, // Varredura com a regra sorteada a cada passo
+    DIVISAO_ALEATORIA    // Volta gigante do GRASP dividida em rotas
+};
+
+struct ConstrucaoPlanejada
+{
+    TipoConstrucao tipo;
+    RegraVarredura regra;
+};
 
-    if (!arquivo.is_open())
+Solucao solucaoGrasp(const Grafo &grafo, clock_t &inicio_execucao, const OpcoesGrasp &opcoes, int num_threads)
+{
+    clock_t inicio = inicio_execucao;
+    auto prazo = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(
+                                                   chrono::duration<double>(opcoes.tempo_limite));
+
+    // Construções determinísticas, feitas mesmo com o prazo esgotado: o guloso,
+    // uma por regra da varredura, a divisão da volta gulosa e as economias. As seguintes
+    // revezam as famílias aleatorizadas pedidas (o GRASP, se nenhuma).
+    vector<ConstrucaoPlanejada> deterministicas = {{TipoConstrucao::GULOSO, RegraVarredura::PELA_CARGA}};
+    vector<TipoConstrucao> aleatorias;
+    if (opcoes.varredura)
     {
-        throw runtime_error("Erro ao criar o arquivo de solução: " + caminho_solucao);
+        for (int regra = 0; regra < NUM_REGRAS_VARREDURA; regra++)
+        {
+            deterministicas.push_back({TipoConstrucao::VARREDURA, static_cast<RegraVarredura>(regra)});
+        }
+        aleatorias.push_back(TipoConstrucao::VARREDURA_ALEATORIA);
+    }
+    if (opcoes.divisao)
+    {
+        deterministicas.push_back({TipoConstrucao::DIVISAO, RegraVarredura::PELA_CARGA});
+        aleatorias.push_back(TipoConstrucao::DIVISAO_ALEATORIA);
+    }
+    if (opcoes.economias)
+    {
+        deterministicas.push_back({TipoConstrucao::ECONOMIAS, RegraVarredura::PELA_CARGA});
+    }
+    if (aleatorias.empty())
+    {
+        aleatorias.push_back(TipoConstrucao::GRASP);
+    }
+
+    long long num_deterministicas = deterministicas.size();
+    long long total = opcoes.inicios > 0    ? max<long long>(opcoes.inicios, num_deterministicas)
+                      : opcoes.tempo_limite > 0 ? numeric_limits<long long>::max()
+                                                : num_deterministicas;
+    size_t tamanho_lrc = max(1, opcoes.tamanho_lrc);
+    if (opcoes.inicios > 0)
+    {
+        num_threads = static_cast<int>(min<long long>(num_threads, total));
+    }
+    num_threads = max(1, num_threads);
+
+    REGISTRO_DEPURACAO("Construções: " << (total < numeric_limits<long long>::max() ? to_string(total)
+                                                                                    : string("sem limite"))
+                       << ", limite de " << opcoes.tempo_limite << " s"
+                       << (opcoes.varredura ? ", varredura de caminhos" : "")
+                       << (opcoes.divisao ? ", volta gigante e divisão" : "")
+                       << (opcoes.economias ? ", economias" : "")
+                       << ", LRC de " << tamanho_lrc << " (alfa " << opcoes.alfa << "), semente "
+                       << opcoes.semente << ", " << num_threads << " thread(s)");
+
+    // Melhor de cada thread, com o índice da construção para desempatar
+    struct MelhorConstrucao
+    {
+        Solucao solucao;
+        long long indice = -1;
+    };
+    vector<MelhorConstrucao> melhores(num_threads);
+    atomic<long long> proxima(0);
+
+    executarEmThreads(num_threads, [&](int id_thread)
+    {
+        // Área de trabalho da thread; o Grafo é só lido
+        CandidatosPorEntrada pendentes(grafo);
+        BuscaIncremental busca(grafo.getAdjacencia());
+        vector<CandidatoServico> lrc;
+        vector<CandidatoServico> empatados;
+        vector<ServicoOrientado> volta;
+        AreaDivisao area_divisao;
+        MelhorConstrucao &melhor = melhores[id_thread];
+
+        auto guloso = [&](int no_atual, int capacidade_livre)
+        { return escolherServico(grafo, busca, pendentes, no_atual, capacidade_livre); };
+
+        while (true)
+        {
+            // O prazo é conferido antes de pegar o índice: as construções feitas
+            // são sempre 0..N-1, e --grasp N repete o resultado sem o prazo
+            if (opcoes.tempo_limite > 0 && proxima.load() >= num_deterministicas &&
+                chrono::steady_clock::now() >= prazo)
+            {
+                break;
+            }
+            long long k = proxima++;
+            if (k >= total)
+            {
+                break;
+            }
+
+            ConstrucaoPlanejada construcao =
+                k < num_deterministicas
+                    ? deterministicas[k]
+                    : ConstrucaoPlanejada{aleatorias[(k - num_deterministicas) % aleatorias.size()],
+                                          RegraVarredura::PELA_CARGA};
+            mt19937_64 gerador(sementeDaConstrucao(opcoes.semente, k));
+            auto grasp = [&](int no_atual, int capacidade_livre)
+            {
+                return sortearServico(grafo, busca, pendentes, no_atual, capacidade_livre, tamanho_lrc, opcoes.alfa,
+                                      gerador, lrc);
+            };
+
+            pendentes.restaurar();
+            Solucao solucao;
+            switch (construcao.tipo)
+            {
+                case TipoConstrucao::GULOSO:
+                    // A construção 0 é o guloso: o resultado nunca fica pior que ele
+                    solucao = construirRotas(grafo, pendentes, guloso, false);
+                    break;
+                case TipoConstrucao::VARREDURA:
+                    solucao = construirRotas(grafo, pendentes, [&](int no_atual, int capacidade_livre)
+                                             { return varrerCaminho(grafo, busca, pendentes, no_atual,
+                                                                    capacidade_livre, construcao.regra, empatados); },
+                                             false);
+                    break;
+                case TipoConstrucao::VARREDURA_ALEATORIA:
+                    solucao = construirRotas(grafo, pendentes, [&](int no_atual, int capacidade_livre)
+                                             {
+                                                 RegraVarredura regra =
+                                                     static_cast<RegraVarredura>(gerador() % NUM_REGRAS_VARREDURA);
+                                                 return varrerCaminho(grafo, busca, pendentes, no_atual,
+                                                                      capacidade_livre, regra, empatados);
+                                             },
+                                             false);
+                    break;
+                case TipoConstrucao::GRASP:
+                    solucao = construirRotas(grafo, pendentes, grasp, false);
+                    break;
+                case TipoConstrucao::DIVISAO:
+                    montarVoltaGigante(grafo, pendentes, [&](int no_atual)
+                                       { return guloso(no_atual, numeric_limits<int>::max()); },
+                                       volta);
+                    solucao = dividirVoltaGigante(grafo, volta, area_divisao);
+                    break;
+                case TipoConstrucao::ECONOMIAS:
+                    solucao = solucaoEconomias(grafo, inicio);
+                    break;
+                case TipoConstrucao::DIVISAO_ALEATORIA:
+                    montarVoltaGigante(grafo, pendentes, [&](int no_atual)
+                                       { return grasp(no_atual, numeric_limits<int>::max()); },
+                                       volta);
+                    solucao = dividirVoltaGigante(grafo, volta, area_divisao);
+                    break;
+            }
+
+            if (melhor.indice == -1 || solucao.custo_total < melhor.solucao.custo_total)
+            {
+                melhor.solucao = move(solucao);
+                melhor.indice = k;
+            }
+        }
+    });
+
+    // Menor custo; no empate, a construção de menor índice (independe das threads)
+    long long construcoes = min<long long>(proxima.load(), total);
+    MelhorConstrucao *vencedora = nullptr;
+    for (MelhorConstrucao &melhor : melhores)
+    {
+        if (melhor.indice != -1 &&
+            (!vencedora || melhor.solucao.custo_total < vencedora->solucao.custo_total ||
+             (melhor.solucao.custo_total == vencedora->solucao.custo_total && melhor.indice < vencedora->indice)))
+        {
+            vencedora = &melhor;
+        }
+    }
+
+    Solucao solucao = move(vencedora->solucao);
+    solucao.tempo_execucao = clock() - inicio;
+
+    REGISTRO_DEPURACAO("Construções: " << construcoes << " feitas; melhor é a " << vencedora->indice
+                       << " com " << solucao.num_rotas << " rotas e custo " << solucao.custo_total);
+
+    return solucao;
+}
+
+Solucao construirSolucao(const Grafo &grafo, clock_t &inicio_execucao, const OpcoesGrasp &opcoes)
+{
+    Solucao solucao =
+        opcoes.ativo() ? solucaoGrasp(grafo, inicio_execucao, opcoes) : solucaoInicial(grafo, inicio_execucao);
+
+    // Sentido ótimo das arestas de cada rota, mantida a ordem dos serviços
+    int orientadas = orientarRotas(grafo, solucao.rotas);
+    if (orientadas > 0)
+    {
+        solucao.custo_total = 0;
+        for (const Rota &rota : solucao.rotas)
+        {
+            solucao.custo_total += rota.custo_total;
+        }
+        REGISTRO_DEPURACAO("Sentidos das arestas refeitos em " << orientadas << " rotas; custo " << solucao.custo_total);
     }
+    solucao.tempo_execucao = clock() - inicio_execucao;
+    return solucao;
+}
 
+void escreverSolucao(ostream &arquivo, const Solucao &solucao, clock_t tempo_total, const Grafo &grafo)
+{
     int deposito = grafo.getDeposito();
 
     // Escrever cabeçalho da solução
     arquivo << solucao.custo_total << endl;
     arquivo << solucao.num_rotas << endl;
-    arquivo << solucao.tempo_execucao << endl;
+    arquivo << tempo_total << endl;
     arquivo << clock() << endl;
 
     // Escrever cada rota
@@ -443,8 +873,22 @@ void salvarSolucao(const string &nome_arquivo, const Solucao &solucao, const str
         // Último nó é sempre o depósito
         arquivo << "(D,0," << deposito << "," << deposito << ")" << endl;
     }
+}
+
+void salvarSolucao(const string &nome_arquivo, const Solucao &solucao, const string &diretorio_saida, const Grafo &grafo)
+{
+    string nome_solucao = "sol-" + nome_arquivo;
+    string caminho_solucao = diretorio_saida + nome_solucao;
 
+    ofstream arquivo(caminho_solucao);
+
+    if (!arquivo.is_open())
+    {
+        throw runtime_error("Erro ao criar o arquivo de solução: " + caminho_solucao);
+    }
+
+    escreverSolucao(arquivo, solucao, solucao.tempo_execucao, grafo);
     arquivo.close();
 
-    cout << "Solução salva em: " << caminho_solucao << endl;
-}
\ No newline at end of file
+    REGISTRO_INFO("Solução salva em: " << caminho_solucao);
+}
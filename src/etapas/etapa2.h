@@ -2,9 +2,12 @@
 #define ETAPA2_H
 
 #include "../core/grafo.h"
+#include "lote.h"
+#include "../core/paralelo.h"
 #include <vector>
 #include <string>
 #include <ctime>
+#include <ostream>
 
 using namespace std;
 
@@ -29,11 +32,26 @@ struct Solucao
     Solucao();
 };
 
-// Função principal da Etapa 2
-void executarEtapa2();
+// Função principal da Etapa 2; true se todas as instâncias foram processadas
+bool executarEtapa2(const OpcoesLote &opcoes = OpcoesLote());
 
 // Funções auxiliares
 Solucao solucaoInicial(const Grafo &grafo, clock_t &inicio_execucao);
+// Melhor de várias construções feitas em paralelo: o guloso, as cinco regras da
+// varredura de caminhos (com opcoes.varredura), a divisão da volta gigante (com
+// opcoes.divisao), as economias (com opcoes.economias) e as demais aleatorizadas (varredura com regra sorteada a cada
+// passo, volta gigante do GRASP dividida, ou GRASP). Com opcoes.inicios fixo,
+// o resultado depende só da semente (não do número de threads); com
+// tempo_limite, depende também de quantas couberam no prazo.
+Solucao solucaoGrasp(const Grafo &grafo, clock_t &inicio_execucao, const OpcoesGrasp &opcoes,
+                     int num_threads = obterNumThreads());
+// solucaoGrasp se o GRASP estiver ativo nas opções, senão solucaoInicial, com o
+// sentido das arestas de cada rota refeito por orientarRotas (busca_local.h)
+Solucao construirSolucao(const Grafo &grafo, clock_t &inicio_execucao, const OpcoesGrasp &opcoes);
+// Nó em que o veículo fica depois de executar o serviço entrando por no_entrada
+int noDeSaida(const Servico &servico, int no_entrada);
+// Grava a solução no formato dos arquivos sol-*.dat (cabeçalho + uma linha por rota)
+void escreverSolucao(ostream &arquivo, const Solucao &solucao, clock_t tempo_total, const Grafo &grafo);
 void salvarSolucao(const string &nome_arquivo, const Solucao &solucao, const string &diretorio_saida, const Grafo &grafo);
 
 #endif // ETAPA2_H
\ No newline at end of file
@@ -1,7 +1,10 @@
 #include "etapa3.h"
+#include "busca_local.h"
+#include "../core/registro.h"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <atomic>
 #include <algorithm>
 #include <limits>
 #include <iomanip>
@@ -12,6 +15,7 @@ EstatisticasOtimizacao::EstatisticasOtimizacao()
 {
     iteracoes_2opt = 0;
     melhorias_encontradas = 0;
+    melhorias_entre_rotas = 0;
     custo_inicial = 0;
     custo_final = 0;
     melhoria_total = 0;
@@ -24,136 +28,197 @@ SolucaoOtimizada::SolucaoOtimizada()
     // Construtores das estruturas base já são chamados automaticamente
 }
 
-void executarEtapa3()
+// Ponto de partida da otimização: a melhor solução conhecida, senão a gravada
+// pela Etapa 2, senão uma construída agora. Arquivos que não correspondem à
+// instância (de outra versão dela, por exemplo) são ignorados.
+static Solucao solucaoDePartida(const Grafo &grafo, const string &nome_arquivo, const OpcoesLote &opcoes,
+                                const MelhoresSolucoes &melhores, clock_t inicio_etapa3)
 {
-    cout << "Iniciando Etapa 3 - Otimização com 2-opt" << endl;
+    Solucao solucao;
+    if (!opcoes.reconstruir)
+    {
+        if (melhores.obter(nome_arquivo, grafo, solucao))
+        {
+            REGISTRO_DEPURACAO("Partindo da melhor solução conhecida (custo " << solucao.custo_total << ")");
+            solucao.tempo_execucao = clock() - inicio_etapa3;
+            return solucao;
+        }
+
+        string caminho_inicial = (fs::path(opcoes.diretorio_iniciais) / ("sol-" + nome_arquivo)).string();
+        if (fs::exists(caminho_inicial))
+        {
+            try
+            {
+                solucao = carregarSolucao(caminho_inicial, grafo);
+                REGISTRO_DEPURACAO("Partindo da solução da Etapa 2 (custo " << solucao.custo_total << ")");
+                solucao.tempo_execucao = clock() - inicio_etapa3;
+                return solucao;
+            }
+            catch (const exception &e)
+            {
+                REGISTRO_AVISO("Solução da Etapa 2 ignorada: " << e.what());
+            }
+        }
+    }
+
+    REGISTRO_DEPURACAO("Gerando solução inicial...");
+    return construirSolucao(grafo, inicio_etapa3, opcoes.grasp);
+}
+
+bool executarEtapa3(const OpcoesLote &opcoes)
+{
+    REGISTRO_INFO("Iniciando Etapa 3 - Otimização por Busca Local");
 
     // INÍCIO DO CLOCK PARA A ETAPA 3
     clock_t inicio_etapa3 = clock();
 
-    string diretorio_dados = "./dados/";
-    string diretorio_saida_etapa2 = "./solucao/";
-    string diretorio_saida_etapa3 = "./solucao_otimizada/";
+    string diretorio_saida_etapa3 =
+        (fs::path(opcoes.diretorio_saida.empty() ? "./solucao_otimizada/" : opcoes.diretorio_saida) / "").string();
 
     // Criar o diretório de saída se não existir
     if (!fs::exists(diretorio_saida_etapa3))
     {
         fs::create_directories(diretorio_saida_etapa3);
-        cout << "Diretório de saída criado: " << diretorio_saida_etapa3 << endl;
+        REGISTRO_INFO("Diretório de saída criado: " << diretorio_saida_etapa3);
     }
 
-    if (!fs::exists(diretorio_dados))
+    REGISTRO_INFO("Processando instâncias em: " << opcoes.entrada);
+    REGISTRO_INFO("Salvando soluções otimizadas em: " << diretorio_saida_etapa3);
+
+    vector<string> instancias = listarInstancias(opcoes.entrada);
+    int total_instancias = instancias.size();
+    if (total_instancias == 0)
     {
-        cerr << "Erro: Diretório de dados não encontrado: " << diretorio_dados << endl;
-        return;
+        REGISTRO_ERRO("Nenhum arquivo .dat encontrado para: " << opcoes.entrada);
+        return false;
     }
 
-    cout << "Processando instâncias em: " << diretorio_dados << endl;
-    cout << "Salvando soluções otimizadas em: " << diretorio_saida_etapa3 << endl;
+    REGISTRO_INFO("Total de instâncias a processar: " << total_instancias);
 
-    int total_instancias = 0;
-    int instancias_processadas = 0;
-    int instancias_sucesso = 0;
-    vector<pair<string, EstatisticasOtimizacao>> todas_estatisticas;
+    MelhoresSolucoes melhores(opcoes.diretorio_melhores);
 
-    // Contar o número total de instâncias para processar
-    for (const auto &entrada : fs::directory_iterator(diretorio_dados))
-    {
-        if (entrada.is_regular_file() && entrada.path().extension() == ".dat")
-        {
-            if (entrada.path().filename().string().substr(0, 4) != "sol-")
-            {
-                total_instancias++;
-            }
-        }
-    }
+    // Estatísticas por índice de instância: o CSV sai na ordem de nome
+    vector<EstatisticasOtimizacao> estatisticas(total_instancias);
+    vector<char> processado(total_instancias, 0);
+    atomic<int> instancias_iniciadas(0);
+    atomic<int> instancias_processadas(0);
 
-    if (total_instancias == 0)
+    processarInstancias(instancias, 3, opcoes.num_jobs, [&](size_t i)
     {
-        cerr << "Nenhum arquivo .dat encontrado no diretório: " << diretorio_dados << endl;
-        return;
-    }
+        string caminho_arquivo = instancias[i];
+        string nome_arquivo = fs::path(caminho_arquivo).filename().string();
 
-    cout << "Total de instâncias a processar: " << total_instancias << endl;
+        REGISTRO_INFO("\n===================================================");
+        REGISTRO_INFO("Processando instância " << ++instancias_iniciadas << "/" << total_instancias
+                      << ": " << nome_arquivo);
+        REGISTRO_INFO("===================================================");
 
-    // Processar cada arquivo .dat no diretório
-    for (const auto &entrada : fs::directory_iterator(diretorio_dados))
-    {
-        if (entrada.is_regular_file() && entrada.path().extension() == ".dat")
+        try
         {
-            string caminho_arquivo = entrada.path().string();
-            string nome_arquivo = entrada.path().filename().string();
+            // Ler o grafo (só as distâncias entre extremidades de serviços e depósito são usadas)
+            Grafo grafo;
+            grafo.lerArquivoDados(caminho_arquivo, ModoDistancias::TERMINAIS);
 
-            // Pular arquivos de solução
-            if (nome_arquivo.substr(0, 4) == "sol-")
-            {
-                continue;
-            }
+            // Solução inicial: guardada (melhor conhecida ou da Etapa 2) ou construída
+            Solucao solucao_inicial = solucaoDePartida(grafo, nome_arquivo, opcoes, melhores, inicio_etapa3);
 
-            instancias_processadas++;
-            cout << "\n===================================================" << endl;
-            cout << "Processando instância " << instancias_processadas << "/" << total_instancias
-                 << ": " << nome_arquivo << endl;
-            cout << "===================================================" << endl;
+            // Otimizar, salvar e atualizar a melhor solução conhecida
+            SolucaoOtimizada solucao_otimizada =
+                otimizarInstancia(grafo, nome_arquivo, solucao_inicial, diretorio_saida_etapa3, melhores);
 
-            try
-            {
-                // Ler o grafo
-                Grafo grafo;
-                grafo.lerArquivoDados(caminho_arquivo);
-
-                // Gerar solução inicial (Etapa 2)
-                cout << "Gerando solução inicial..." << endl;
-                Solucao solucao_inicial = solucaoInicial(grafo, inicio_etapa3);
-
-                // Otimizar solução com 2-opt (Etapa 3)
-                cout << "Aplicando otimização 2-opt..." << endl;
-                SolucaoOtimizada solucao_otimizada = otimizarSolucao(grafo, solucao_inicial);
-
-                // Salvar solução otimizada
-                salvarSolucaoOtimizada(nome_arquivo, solucao_otimizada, diretorio_saida_etapa3, grafo);
-
-                // Armazenar estatísticas
-                todas_estatisticas.push_back({nome_arquivo, solucao_otimizada.estatisticas});
-
-                // Mostrar resumo
-                cout << "\n✓ Resumo da otimização para " << nome_arquivo << ":" << endl;
-                cout << "Custo inicial: " << solucao_otimizada.estatisticas.custo_inicial << endl;
-                cout << "Custo otimizado: " << solucao_otimizada.estatisticas.custo_final << endl;
-                cout << "Melhoria: " << solucao_otimizada.estatisticas.melhoria_total
-                     << " (" << fixed << setprecision(2)
-                     << solucao_otimizada.estatisticas.percentual_melhoria << "%)" << endl;
-                cout << "Iterações 2-opt: " << solucao_otimizada.estatisticas.iteracoes_2opt << endl;
-                cout << "Melhorias encontradas: " << solucao_otimizada.estatisticas.melhorias_encontradas << endl;
-
-                instancias_sucesso++;
-            }
-            catch (const exception &e)
-            {
-                cerr << "✗ Erro ao processar instância " << nome_arquivo << ": " << e.what() << endl;
-            }
+            // Armazenar estatísticas
+            estatisticas[i] = solucao_otimizada.estatisticas;
+            processado[i] = 1;
+        }
+        catch (const exception &e)
+        {
+            REGISTRO_ERRO("✗ Erro ao processar instância " << nome_arquivo << ": " << e.what());
+        }
 
-            cout << "---------------------------------------------------" << endl;
-            cout << "Progresso: " << instancias_processadas << "/" << total_instancias
-                 << " (" << (instancias_processadas * 100 / total_instancias) << "%)" << endl;
+        int concluidas = ++instancias_processadas;
+        REGISTRO_INFO("---------------------------------------------------");
+        REGISTRO_INFO("Progresso: " << concluidas << "/" << total_instancias
+                      << " (" << (concluidas * 100 / total_instancias) << "%)");
+    });
+
+    vector<pair<string, EstatisticasOtimizacao>> todas_estatisticas;
+    for (int i = 0; i < total_instancias; i++)
+    {
+        if (processado[i])
+        {
+            todas_estatisticas.push_back({fs::path(instancias[i]).filename().string(), estatisticas[i]});
         }
     }
+    int instancias_sucesso = todas_estatisticas.size();
 
     // Exportar estatísticas consolidadas
     if (!todas_estatisticas.empty())
     {
-        exportarEstatisticasOtimizacao(todas_estatisticas);
+        exportarEstatisticasOtimizacao(todas_estatisticas, opcoes.diretorio_resultados);
     }
 
     // Calcular tempo total da etapa 3
     clock_t tempo_total_etapa3 = clock() - inicio_etapa3;
 
-    cout << "\n=== ETAPA 3 CONCLUÍDA ===" << endl;
-    cout << "Total processado: " << instancias_sucesso << "/" << total_instancias << endl;
-    cout << "Tempo total da Etapa 3: " << tempo_total_etapa3 << " clocks ("
-         << static_cast<double>(tempo_total_etapa3) / CLOCKS_PER_SEC << " segundos)" << endl;
-    cout << "Soluções otimizadas salvas em: " << diretorio_saida_etapa3 << endl;
-    cout << "Estatísticas exportadas para: resultados_otimizacao_2opt.csv" << endl;
+    REGISTRO_INFO("\n=== ETAPA 3 CONCLUÍDA ===");
+    REGISTRO_INFO("Total processado: " << instancias_sucesso << "/" << total_instancias);
+    REGISTRO_INFO("Tempo total da Etapa 3: " << tempo_total_etapa3 << " clocks ("
+                  << static_cast<double>(tempo_total_etapa3) / CLOCKS_PER_SEC << " segundos)");
+    REGISTRO_INFO("Soluções otimizadas salvas em: " << diretorio_saida_etapa3);
+    return instancias_sucesso == total_instancias;
+}
+
+SolucaoOtimizada otimizarInstancia(const Grafo &grafo, const string &nome_arquivo, const Solucao &solucao_inicial,
+                                   const string &diretorio_saida, const MelhoresSolucoes &melhores)
+{
+    // Otimizar solução com busca local (Etapa 3)
+    REGISTRO_DEPURACAO("Aplicando busca local...");
+    SolucaoOtimizada solucao_otimizada = otimizarSolucao(grafo, solucao_inicial);
+
+    // Salvar solução otimizada e guardá-la se for a melhor até agora
+    salvarSolucaoOtimizada(nome_arquivo, solucao_otimizada, diretorio_saida, grafo);
+    if (melhores.atualizar(nome_arquivo, solucao_otimizada.solucao_otimizada, grafo))
+    {
+        REGISTRO_DEPURACAO("Nova melhor solução conhecida: " << solucao_otimizada.estatisticas.custo_final);
+    }
+
+    // Mostrar resumo
+    REGISTRO_INFO("\n✓ Resumo da otimização para " << nome_arquivo << ":");
+    REGISTRO_INFO("Custo inicial: " << solucao_otimizada.estatisticas.custo_inicial);
+    REGISTRO_INFO("Custo otimizado: " << solucao_otimizada.estatisticas.custo_final);
+    REGISTRO_INFO("Melhoria: " << solucao_otimizada.estatisticas.melhoria_total
+                  << " (" << fixed << setprecision(2)
+                  << solucao_otimizada.estatisticas.percentual_melhoria << "%)");
+    REGISTRO_INFO("Iterações 2-opt: " << solucao_otimizada.estatisticas.iteracoes_2opt);
+    REGISTRO_INFO("Melhorias encontradas: " << solucao_otimizada.estatisticas.melhorias_encontradas);
+    REGISTRO_INFO("Movimentos entre rotas: " << solucao_otimizada.estatisticas.melhorias_entre_rotas);
+
+    return solucao_otimizada;
+}
+
+// Aplica 2-opt em cada rota individualmente
+static void otimizarRotasIsoladas(const Grafo &grafo, vector<Rota> &rotas, EstatisticasOtimizacao &stats)
+{
+    for (size_t i = 0; i < rotas.size(); i++)
+    {
+        REGISTRO_RASTRO("Otimizando rota " << (i + 1) << "/" << rotas.size() << "...");
+
+        Rota rota_original = rotas[i];
+        Rota rota_otimizada = aplicar2Opt(grafo, rota_original, stats);
+
+        // Atualizar a rota se houve melhoria
+        if (rota_otimizada.custo_total < rota_original.custo_total)
+        {
+            rotas[i] = rota_otimizada;
+            REGISTRO_DEPURACAO("  Rota " << (i + 1) << " melhorada: "
+                               << rota_original.custo_total << " -> " << rota_otimizada.custo_total
+                               << " (melhoria: " << (rota_original.custo_total - rota_otimizada.custo_total) << ")");
+        }
+        else
+        {
+            REGISTRO_DEPURACAO("  Rota " << (i + 1) << " não foi melhorada");
+        }
+    }
 }
 
 SolucaoOtimizada otimizarSolucao(const Grafo &grafo, const Solucao &solucao_inicial)
@@ -167,29 +232,40 @@ SolucaoOtimizada otimizarSolucao(const Grafo &grafo, const Solucao &solucao_inic
     resultado.estatisticas.custo_inicial = solucao_inicial.custo_total;
     resultado.estatisticas.custo_final = solucao_inicial.custo_total;
 
-    cout << "Iniciando otimização 2-opt para " << solucao_inicial.rotas.size() << " rotas..." << endl;
+    REGISTRO_DEPURACAO("Iniciando busca local para " << solucao_inicial.rotas.size() << " rotas...");
 
-    // Aplicar 2-opt em cada rota individualmente
-    for (size_t i = 0; i < resultado.solucao_otimizada.rotas.size(); i++)
+    // Rodadas de 2-opt, sentido ótimo das arestas, Or-opt e movimentos entre
+    // rotas até que uma rodada inteira não encontre melhoria (cada um para no
+    // seu ótimo local)
+    vector<Rota> &rotas = resultado.solucao_otimizada.rotas;
+    while (true)
     {
-        cout << "Otimizando rota " << (i + 1) << "/" << resultado.solucao_otimizada.rotas.size() << "..." << endl;
+        int melhorias_anteriores =
+            resultado.estatisticas.melhorias_encontradas + resultado.estatisticas.melhorias_entre_rotas;
 
-        Rota rota_original = resultado.solucao_otimizada.rotas[i];
-        Rota rota_otimizada = aplicar2Opt(grafo, rota_original, resultado.estatisticas);
+        otimizarRotasIsoladas(grafo, rotas, resultado.estatisticas);
 
-        // Atualizar a rota se houve melhoria
-        if (rota_otimizada.custo_total < rota_original.custo_total)
-        {
-            resultado.solucao_otimizada.rotas[i] = rota_otimizada;
-            cout << "  Rota " << (i + 1) << " melhorada: "
-                 << rota_original.custo_total << " -> " << rota_otimizada.custo_total
-                 << " (melhoria: " << (rota_original.custo_total - rota_otimizada.custo_total) << ")" << endl;
-        }
-        else
+        int rotas_orientadas = orientarRotas(grafo, rotas);
+        resultado.estatisticas.melhorias_encontradas += rotas_orientadas;
+        REGISTRO_DEPURACAO("Sentidos das arestas refeitos em " << rotas_orientadas << " rotas");
+
+        int movimentos_or_opt = melhorarOrOpt(grafo, rotas);
+        resultado.estatisticas.melhorias_encontradas += movimentos_or_opt;
+        REGISTRO_DEPURACAO("Movimentos Or-opt: " << movimentos_or_opt << "; " << rotas.size() << " rotas");
+
+        MovimentosEntreRotas movimentos = melhorarEntreRotas(grafo, rotas);
+        resultado.estatisticas.melhorias_entre_rotas += movimentos.total();
+        REGISTRO_DEPURACAO("Movimentos entre rotas: " << movimentos.realocacoes << " realocações, "
+                           << movimentos.trocas << " trocas, " << movimentos.dois_opt_estrela << " 2-opt*, "
+                           << movimentos.cross << " CROSS; " << rotas.size() << " rotas");
+
+        if (resultado.estatisticas.melhorias_encontradas + resultado.estatisticas.melhorias_entre_rotas ==
+            melhorias_anteriores)
         {
-            cout << "  Rota " << (i + 1) << " não foi melhorada" << endl;
+            break;
         }
     }
+    resultado.solucao_otimizada.num_rotas = rotas.size();
 
     // Recalcular custo total da solução
     resultado.solucao_otimizada.custo_total = 0;
@@ -210,9 +286,9 @@ SolucaoOtimizada otimizarSolucao(const Grafo &grafo, const Solucao &solucao_inic
 
     resultado.estatisticas.tempo_otimizacao = clock() - inicio_otimizacao;
 
-    cout << "Otimização concluída!" << endl;
-    cout << "Melhoria total: " << resultado.estatisticas.melhoria_total
-         << " (" << fixed << setprecision(2) << resultado.estatisticas.percentual_melhoria << "%)" << endl;
+    REGISTRO_DEPURACAO("Otimização concluída!");
+    REGISTRO_DEPURACAO("Melhoria total: " << resultado.estatisticas.melhoria_total
+                       << " (" << fixed << setprecision(2) << resultado.estatisticas.percentual_melhoria << "%)");
 
     return resultado;
 }
@@ -220,61 +296,98 @@ SolucaoOtimizada otimizarSolucao(const Grafo &grafo, const Solucao &solucao_inic
 Rota aplicar2Opt(const Grafo &grafo, const Rota &rota_original, EstatisticasOtimizacao &stats)
 {
     Rota melhor_rota = rota_original;
-    bool melhorou = true;
+    int n = melhor_rota.nos.size();
     int iteracoes_locais = 0;
 
-    // Só aplicar 2-opt se a rota tiver pelo menos 4 serviços (para poder fazer trocas)
-    if (rota_original.nos.size() < 4)
+    // Só aplicar 2-opt se a rota tiver pelo menos 2 serviços (para poder fazer trocas)
+    if (n < 2)
     {
         return melhor_rota;
     }
 
-    while (melhorou && iteracoes_locais < 1000) // Limitar iterações para evitar loops infinitos
+    const vector<Servico> &servicos = grafo.getServicos();
+    int deposito = grafo.getDeposito();
+
+    // Posições 1..n são os serviços; 0 e n + 1, o depósito. O movimento inverte
+    // a ordem das posições a..b mantendo o sentido de cada serviço, então só os
+    // deslocamentos mudam: os de dentro do trecho passam a ser percorridos de
+    // trás para a frente (d(saída de k + 1, entrada de k), diferente do sentido
+    // direto por causa dos arcos) e os dois das pontas são trocados. Com somas
+    // prefixas dos dois sentidos, cada movimento custa O(1); a carga não muda.
+    vector<int> entrada(n + 2), saida(n + 2);
+    vector<long long> direto(n + 2), inverso(n + 2);
+    auto prepararRota = [&]()
+    {
+        entrada[0] = saida[0] = deposito;
+        entrada[n + 1] = saida[n + 1] = deposito;
+        for (int k = 1; k <= n; k++)
+        {
+            const auto &[id_servico, no_entrada] = melhor_rota.nos[k - 1];
+            entrada[k] = no_entrada;
+            saida[k] = noDeSaida(servicos[id_servico - 1], no_entrada);
+        }
+
+        // direto[k]: deslocamentos 0→1→...→k; inverso[k]: os mesmos trechos
+        // entre serviços (1..k) percorridos no sentido contrário
+        direto[0] = inverso[0] = inverso[1] = 0;
+        for (int k = 1; k <= n + 1; k++)
+        {
+            direto[k] = direto[k - 1] + grafo.getDistancia(saida[k - 1], entrada[k]);
+        }
+        for (int k = 2; k <= n; k++)
+        {
+            inverso[k] = inverso[k - 1] + grafo.getDistancia(saida[k], entrada[k - 1]);
+        }
+    };
+
+    // Melhor melhoria a cada passada, aplicada no lugar; para quando nenhum
+    // movimento melhora (ou no limite de passadas, como antes)
+    while (iteracoes_locais < 1000)
     {
-        melhorou = false;
         iteracoes_locais++;
         stats.iteracoes_2opt++;
+        prepararRota();
 
-        // Tentar todas as combinações de 2-opt
-        for (size_t i = 0; i < melhor_rota.nos.size() - 1; i++)
+        long long melhor_delta = 0;
+        int melhor_a = 0, melhor_b = 0;
+        for (int a = 1; a < n; a++)
         {
-            for (size_t j = i + 2; j < melhor_rota.nos.size(); j++)
+            for (int b = a + 1; b <= n; b++)
             {
-                // Criar nova rota com movimento 2-opt
-                Rota nova_rota = melhor_rota;
-
-                // Reverter o segmento entre i+1 e j
-                reverse(nova_rota.nos.begin() + i + 1, nova_rota.nos.begin() + j + 1);
-
-                // Recalcular custo da nova rota
-                double novo_custo = calcularCustoRota(grafo, nova_rota);
-                nova_rota.custo_total = static_cast<int>(novo_custo);
-
-                // Verificar se a nova rota é válida e melhor
-                if (verificarValidadeRota(grafo, nova_rota) && nova_rota.custo_total < melhor_rota.custo_total)
+                long long antes = direto[b + 1] - direto[a - 1];
+                long long depois = grafo.getDistancia(saida[a - 1], entrada[b]) + (inverso[b] - inverso[a]) +
+                                   grafo.getDistancia(saida[a], entrada[b + 1]);
+                if (depois - antes < melhor_delta)
                 {
-                    melhor_rota = nova_rota;
-                    melhorou = true;
-                    stats.melhorias_encontradas++;
-                    break;
+                    melhor_delta = depois - antes;
+                    melhor_a = a;
+                    melhor_b = b;
                 }
             }
-            if (melhorou)
-                break; // Reiniciar busca com a nova rota
         }
+
+        if (melhor_delta >= 0)
+        {
+            break;
+        }
+
+        reverse(melhor_rota.nos.begin() + melhor_a - 1, melhor_rota.nos.begin() + melhor_b);
+        stats.melhorias_encontradas++;
     }
 
+    melhor_rota.custo_total = calcularCustoRota(grafo, melhor_rota);
     return melhor_rota;
 }
 
-double calcularCustoRota(const Grafo &grafo, const Rota &rota)
+Custo calcularCustoRota(const Grafo &grafo, const Rota &rota)
 {
     if (rota.nos.empty())
     {
-        return 0.0;
+        return 0;
     }
 
-    double custo_total = 0.0;
+    // Soma exata em inteiros; um trecho sem caminho satura em CUSTO_INFINITO
+    Custo custo_total = 0;
     int deposito = grafo.getDeposito();
     int no_atual = deposito;
 
@@ -282,11 +395,11 @@ double calcularCustoRota(const Grafo &grafo, const Rota &rota)
     for (const auto &[id_servico, no_entrada] : rota.nos)
     {
         // Custo para chegar ao serviço
-        custo_total += grafo.getDistancia(no_atual, no_entrada);
+        custo_total = somarCustos(custo_total, grafo.getDistancia(no_atual, no_entrada));
 
         // Custo do serviço
         const Servico &servico = grafo.getServicos()[id_servico - 1];
-        custo_total += servico.custo_servico;
+        custo_total = somarCustos<Custo>(custo_total, servico.custo_servico);
 
         // Determinar nó de saída após executar o serviço
         if (servico.tipo == 'N')
@@ -304,7 +417,7 @@ double calcularCustoRota(const Grafo &grafo, const Rota &rota)
     }
 
     // Custo de retorno ao depósito
-    custo_total += grafo.getDistancia(no_atual, deposito);
+    custo_total = somarCustos(custo_total, grafo.getDistancia(no_atual, deposito));
 
     return custo_total;
 }
@@ -337,84 +450,27 @@ void salvarSolucaoOtimizada(const string &nome_arquivo, const SolucaoOtimizada &
 
     const Solucao &solucao = solucao_otim.solucao_otimizada;
 
-    int deposito = grafo.getDeposito();
-
-    // Escrever cabeçalho da solução
-    arquivo << solucao.custo_total << endl;
-    arquivo << solucao.num_rotas << endl;
-    arquivo << solucao.tempo_execucao + solucao_otim.estatisticas.tempo_otimizacao << endl; // Tempo total
-    arquivo << clock() << endl;
-
-    // Escrever cada rota
-    for (size_t i = 0; i < solucao.rotas.size(); i++)
-    {
-        const Rota &rota = solucao.rotas[i];
-
-        // Formato correto: índice_do_depósito(sempre 0) dia(sempre 1) id_rota demanda custo total_visitas
-        arquivo << " 0 1 " << (i + 1) << " " << rota.demanda_total << " " << rota.custo_total << " " << (rota.nos.size() + 1) << " ";
-
-        // Primeiro nó é sempre o depósito
-        arquivo << "(D,0," << deposito << "," << deposito << ") ";
-
-        // Escrever cada serviço na rota
-        for (const auto &no : rota.nos)
-        {
-            int id_servico = no.first;
-            int id_no = no.second;
-
-            if (id_servico == 0)
-            {
-                // Se é o depósito
-                arquivo << "(D,0," << deposito << "," << deposito << ") ";
-            }
-            else
-            {
-                // Se é um serviço
-                const Servico &servico = grafo.getServicos()[id_servico - 1];
-
-                if (servico.tipo == 'N')
-                {
-                    // Nó requerido
-                    arquivo << "(S " << id_servico << "," << id_no << "," << id_no << ") ";
-                }
-                else
-                {
-                    // Aresta ou arco requerido
-                    int origem = servico.origem;
-                    int destino = servico.destino;
-
-                    if (id_no == origem)
-                    {
-                        arquivo << "(S " << id_servico << "," << origem << "," << destino << ") ";
-                    }
-                    else
-                    {
-                        arquivo << "(S " << id_servico << "," << destino << "," << origem << ") ";
-                    }
-                }
-            }
-        }
-
-        // Último nó é sempre o depósito
-        arquivo << "(D,0," << deposito << "," << deposito << ")" << endl;
-    }
-
+    // Tempo total: construção + otimização
+    escreverSolucao(arquivo, solucao, solucao.tempo_execucao + solucao_otim.estatisticas.tempo_otimizacao, grafo);
     arquivo.close();
 
-    cout << "Solução otimizada salva em: " << caminho_solucao << endl;
+    REGISTRO_INFO("Solução otimizada salva em: " << caminho_solucao);
 }
 
-void exportarEstatisticasOtimizacao(const vector<pair<string, EstatisticasOtimizacao>> &todas_estatisticas)
+void exportarEstatisticasOtimizacao(const vector<pair<string, EstatisticasOtimizacao>> &todas_estatisticas,
+                                    const string &diretorio_resultados)
 {
-    ofstream arquivo("resultados_otimizacao_2opt.csv");
+    fs::create_directories(diretorio_resultados);
+    string arquivo_saida = (fs::path(diretorio_resultados) / "resultados_otimizacao_2opt.csv").string();
+    ofstream arquivo(arquivo_saida);
 
     if (!arquivo.is_open())
     {
-        throw runtime_error("Não foi possível criar o arquivo: resultados_otimizacao_2opt.csv");
+        throw runtime_error("Não foi possível criar o arquivo: " + arquivo_saida);
     }
 
     // Cabeçalho
-    arquivo << "Instancia,CustoInicial,CustoFinal,MelhoriaAbsoluta,MelhoriaPercentual,Iteracoes2opt,MelhoriasEncontradas,TempoOtimizacao\n";
+    arquivo << "Instancia,CustoInicial,CustoFinal,MelhoriaAbsoluta,MelhoriaPercentual,Iteracoes2opt,MelhoriasEncontradas,TempoOtimizacao,MelhoriasEntreRotas\n";
 
     // Dados de cada instância
     for (const auto &[nome, stats] : todas_estatisticas)
@@ -426,9 +482,10 @@ void exportarEstatisticasOtimizacao(const vector<pair<string, EstatisticasOtimiz
                 << fixed << setprecision(2) << stats.percentual_melhoria << ","
                 << stats.iteracoes_2opt << ","
                 << stats.melhorias_encontradas << ","
-                << stats.tempo_otimizacao << "\n";
+                << stats.tempo_otimizacao << ","
+                << stats.melhorias_entre_rotas << "\n";
     }
 
     arquivo.close();
-    cout << "Estatísticas de otimização exportadas para: resultados_otimizacao_2opt.csv" << endl;
+    REGISTRO_INFO("Estatísticas de otimização exportadas para: " << arquivo_saida);
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "../core/grafo.h"
 #include "etapa2.h" // Para reutilizar estruturas Rota e Solucao
+#include "solucoes.h"
 #include <vector>
 #include <string>
 #include <ctime>
@@ -14,6 +15,7 @@ struct EstatisticasOtimizacao
 {
     int iteracoes_2opt;
     int melhorias_encontradas;
+    int melhorias_entre_rotas;
     int custo_inicial;
     int custo_final;
     int melhoria_total;
@@ -33,13 +35,18 @@ struct SolucaoOtimizada
     SolucaoOtimizada();
 };
 
-// Função principal da Etapa 3
-void executarEtapa3();
+// Função principal da Etapa 3; true se todas as instâncias foram processadas
+bool executarEtapa3(const OpcoesLote &opcoes = OpcoesLote());
 
-// Funções de otimização 2-opt
+// Otimiza a solução de partida de uma instância, grava o resultado em
+// diretorio_saida e o registra nas melhores soluções conhecidas se for mais barato
+SolucaoOtimizada otimizarInstancia(const Grafo &grafo, const string &nome_arquivo, const Solucao &solucao_inicial,
+                                   const string &diretorio_saida, const MelhoresSolucoes &melhores);
+
+// Otimização: 2-opt, Or-opt e sentido das arestas em cada rota e movimentos entre rotas (busca_local.h)
 SolucaoOtimizada otimizarSolucao(const Grafo &grafo, const Solucao &solucao_inicial);
 Rota aplicar2Opt(const Grafo &grafo, const Rota &rota_original, EstatisticasOtimizacao &stats);
-double calcularCustoRota(const Grafo &grafo, const Rota &rota);
+Custo calcularCustoRota(const Grafo &grafo, const Rota &rota);
 bool verificarValidadeRota(const Grafo &grafo, const Rota &rota);
 
 // Função para salvar solução otimizada
@@ -47,6 +54,7 @@ void salvarSolucaoOtimizada(const string &nome_arquivo, const SolucaoOtimizada &
                             const string &diretorio_saida, const Grafo &grafo);
 
 // Função para exportar estatísticas
-void exportarEstatisticasOtimizacao(const vector<pair<string, EstatisticasOtimizacao>> &todas_estatisticas);
+void exportarEstatisticasOtimizacao(const vector<pair<string, EstatisticasOtimizacao>> &todas_estatisticas,
+                                    const string &diretorio_resultados);
 
 #endif // ETAPA3_H
\ No newline at end of file
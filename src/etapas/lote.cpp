@@ -0,0 +1,275 @@
+#include "lote.h"
+#include "etapa1.h"
+#include "etapa2.h"
+#include "etapa3.h"
+#include "pipeline.h"
+#include "../core/paralelo.h"
+#include "../core/registro.h"
+#include "../io/leitor_arquivo.h"
+#include <filesystem>
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+// Casamento de nome com padrão de shell: * (qualquer sequência) e ? (um caractere)
+static bool casaPadrao(const string &padrao, const string &nome)
+{
+    size_t p = 0, n = 0;
+    size_t estrela = string::npos, retorno = 0;
+    while (n < nome.size())
+    {
+        if (p < padrao.size() && (padrao[p] == '?' || padrao[p] == nome[n]))
+        {
+            p++;
+            n++;
+        }
+        else if (p < padrao.size() && padrao[p] == '*')
+        {
+            estrela = p++;
+            retorno = n;
+        }
+        else if (estrela != string::npos)
+        {
+            // Estende o trecho coberto pela última * e tenta de novo
+            p = estrela + 1;
+            n = ++retorno;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    while (p < padrao.size() && padrao[p] == '*')
+    {
+        p++;
+    }
+    return p == padrao.size();
+}
+
+vector<string> listarInstancias(const string &padrao)
+{
+    fs::path caminho(padrao);
+    fs::path diretorio;
+    string padrao_nome;
+
+    if (fs::is_directory(caminho))
+    {
+        diretorio = caminho;
+        padrao_nome = "*.dat";
+    }
+    else
+    {
+        diretorio = caminho.has_parent_path() ? caminho.parent_path() : fs::path(".");
+        padrao_nome = caminho.filename().string();
+    }
+
+    if (!fs::is_directory(diretorio))
+    {
+        throw runtime_error("Diretório de dados não encontrado: " + diretorio.string());
+    }
+
+    vector<string> instancias;
+    for (const auto &entrada : fs::directory_iterator(diretorio))
+    {
+        string nome_arquivo = entrada.path().filename().string();
+        if (entrada.is_regular_file() && nome_arquivo.substr(0, 4) != "sol-" &&
+            casaPadrao(padrao_nome, nome_arquivo))
+        {
+            instancias.push_back(entrada.path().string());
+        }
+    }
+    sort(instancias.begin(), instancias.end());
+    return instancias;
+}
+
+double estimarCustoInstancia(const string &caminho_arquivo, int etapa)
+{
+    ResumoInstancia resumo;
+    try
+    {
+        resumo = LeitorArquivo::lerResumoInstancia(caminho_arquivo);
+    }
+    catch (const exception &)
+    {
+        return 0; // O erro aparece quando a instância for processada
+    }
+
+    double n = resumo.num_vertices;
+    double m = 2.0 * resumo.num_arestas + resumo.num_arcos;
+    double s = resumo.num_vertices_requeridos + resumo.num_arestas_requeridas + resumo.num_arcos_requeridos;
+
+    // Etapa 1: caminhos de todos os pares e intermediação, ~n³.
+    // Etapas 2 e 3: Dijkstra a partir de ~2s terminais e construção/2-opt ~s².
+    if (etapa == 1)
+    {
+        return n * n * n;
+    }
+    return 2.0 * s * (n + m) + s * s;
+}
+
+void processarInstancias(const vector<string> &instancias, int etapa, int num_jobs,
+                         const function<void(size_t)> &processar)
+{
+    vector<double> custos(instancias.size());
+    for (size_t i = 0; i < instancias.size(); i++)
+    {
+        custos[i] = estimarCustoInstancia(instancias[i], etapa);
+    }
+
+    // Maiores primeiro; a distribuição dinâmica de paraleloPara entrega a
+    // próxima da fila a cada thread que termina
+    vector<size_t> ordem(instancias.size());
+    iota(ordem.begin(), ordem.end(), 0);
+    stable_sort(ordem.begin(), ordem.end(), [&](size_t a, size_t b) { return custos[a] > custos[b]; });
+
+    int jobs = max(1, min(num_jobs, static_cast<int>(instancias.size())));
+    paraleloPara(0, static_cast<int>(ordem.size()), jobs, [&](int k, int)
+                 { processar(ordem[k]); });
+}
+
+static void mostrarUso(const char *programa)
+{
+    // Direto no console: a ajuda pedida não depende de --nivel
+    descarregarRegistro();
+    cout << "Uso: " << programa << " --etapa N|--pipeline [opções]\n"
+         << "  --etapa N          1 (métricas), 2 (soluções iniciais) ou 3 (otimização por busca local)\n"
+         << "  --pipeline         Etapas 1, 2 e 3 com uma leitura por instância\n"
+         << "  --entrada PADRAO   Instâncias: diretório, arquivo ou padrão (padrão: ./dados/*.dat)\n"
+         << "  --saida DIR        Diretório das soluções (Etapas 2 e 3)\n"
+         << "  --resultados DIR   Diretório dos CSVs (padrão: .)\n"
+         << "  --iniciais DIR     Soluções da Etapa 2 usadas pela Etapa 3 (padrão: ./solucao/)\n"
+         << "  --melhores DIR     Melhores soluções conhecidas (padrão: ./melhores_solucoes/)\n"
+         << "  --reconstruir      Etapa 3 constrói a solução inicial em vez de partir das guardadas\n"
+         << "  --grasp N          Soluções iniciais: melhor de N construções aleatorizadas (GRASP)\n"
+         << "  --tempo-grasp S    GRASP por até S segundos por instância (com ou sem --grasp)\n"
+         << "  --varredura        Inclui a varredura de caminhos (5 regras; aleatorizada com --grasp)\n"
+         << "  --divisao          Inclui a volta gigante dividida em rotas (aleatorizada com --grasp)\n"
+         << "  --economias        Inclui a construção por economias (Clarke e Wright)\n"
+         << "  --lrc K            GRASP sorteia entre até K serviços próximos (padrão: 3)\n"
+         << "  --alfa A           GRASP só sorteia a até (1 + A) vezes a menor distância (padrão: 0.1)\n"
+         << "  --semente N        Semente do GRASP (padrão: 1)\n"
+         << "  --jobs N           Instâncias em paralelo (padrão: 1)\n"
+         << "  --threads N        Threads de cada instância (padrão: núcleos / jobs)\n"
+         << "  --sem-cache        Não ler nem gravar o cache de caminhos mínimos\n"
+         << "  --nivel N          Mensagens: 0 erros ... 4 rastro (padrão: 2)" << endl;
+}
+
+int executarLinhaDeComando(int argc, char *argv[])
+{
+    OpcoesLote opcoes;
+    int etapa = 0;
+    bool pipeline = false;
+    int num_threads = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string opcao = argv[i];
+        auto valor = [&]() -> string
+        {
+            if (i + 1 >= argc)
+            {
+                throw runtime_error("Faltou o valor de " + opcao);
+            }
+            return argv[++i];
+        };
+
+        if (opcao == "--etapa")
+            etapa = stoi(valor());
+        else if (opcao == "--pipeline")
+            pipeline = true;
+        else if (opcao == "--entrada")
+            opcoes.entrada = valor();
+        else if (opcao == "--saida")
+            opcoes.diretorio_saida = valor();
+        else if (opcao == "--resultados")
+            opcoes.diretorio_resultados = valor();
+        else if (opcao == "--iniciais")
+            opcoes.diretorio_iniciais = valor();
+        else if (opcao == "--melhores")
+            opcoes.diretorio_melhores = valor();
+        else if (opcao == "--reconstruir")
+            opcoes.reconstruir = true;
+        else if (opcao == "--grasp")
+            opcoes.grasp.inicios = stoi(valor());
+        else if (opcao == "--tempo-grasp")
+            opcoes.grasp.tempo_limite = stod(valor());
+        else if (opcao == "--varredura")
+            opcoes.grasp.varredura = true;
+        else if (opcao == "--divisao")
+            opcoes.grasp.divisao = true;
+        else if (opcao == "--economias")
+            opcoes.grasp.economias = true;
+        else if (opcao == "--lrc")
+            opcoes.grasp.tamanho_lrc = stoi(valor());
+        else if (opcao == "--alfa")
+            opcoes.grasp.alfa = stod(valor());
+        else if (opcao == "--semente")
+            opcoes.grasp.semente = stoull(valor());
+        else if (opcao == "--jobs")
+            opcoes.num_jobs = stoi(valor());
+        else if (opcao == "--threads")
+            num_threads = stoi(valor());
+        else if (opcao == "--sem-cache")
+            Grafo::definirCacheCaminhos(false);
+        else if (opcao == "--nivel")
+            definirNivelRegistro(static_cast<NivelRegistro>(clamp(stoi(valor()), 0, 4)));
+        else if (opcao == "--ajuda" || opcao == "-h")
+        {
+            mostrarUso(argv[0]);
+            return 0;
+        }
+        else
+        {
+            throw runtime_error("Opção desconhecida: " + opcao + " (use --ajuda)");
+        }
+    }
+
+    // Exatamente um de --etapa (1 a 3) e --pipeline
+    bool etapa_valida = etapa >= 1 && etapa <= 3;
+    if (pipeline ? etapa != 0 : !etapa_valida)
+    {
+        mostrarUso(argv[0]);
+        return 2;
+    }
+    if (opcoes.num_jobs < 1)
+    {
+        throw runtime_error("--jobs deve ser pelo menos 1");
+    }
+    if (opcoes.grasp.inicios < 0 || opcoes.grasp.tempo_limite < 0 || opcoes.grasp.alfa < 0 ||
+        opcoes.grasp.tamanho_lrc < 1)
+    {
+        throw runtime_error("--grasp, --tempo-grasp e --alfa não podem ser negativos e --lrc deve ser pelo menos 1");
+    }
+
+    // Sem --threads, os núcleos são divididos entre as instâncias simultâneas
+    if (num_threads > 0)
+    {
+        definirNumThreads(num_threads);
+    }
+    else if (opcoes.num_jobs > 1)
+    {
+        definirNumThreads(max(1, obterNumThreads() / opcoes.num_jobs));
+    }
+
+    bool sucesso = false;
+    switch (pipeline ? 0 : etapa)
+    {
+        case 0:
+            sucesso = executarPipeline(opcoes);
+            break;
+        case 1:
+            sucesso = executarEtapa1(opcoes);
+            break;
+        case 2:
+            sucesso = executarEtapa2(opcoes);
+            break;
+        case 3:
+            sucesso = executarEtapa3(opcoes);
+            break;
+    }
+    return sucesso ? 0 : 1;
+}
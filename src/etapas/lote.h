@@ -0,0 +1,67 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Construção de várias soluções, da qual fica a melhor: o guloso, as regras da
+// varredura de caminhos (se varredura), a volta gigante dividida em rotas (se
+// divisao), as economias (se economias) e construções aleatorizadas (da
+// varredura, da divisão ou, sem elas, GRASP). Ativa com inicios > 1,
+// tempo_limite > 0 ou alguma das famílias; senão só o guloso.
+struct OpcoesGrasp
+{
+    int inicios;         // Construções; a primeira é sempre o guloso (0 = até o tempo_limite)
+    bool varredura;      // Varredura de caminhos: 5 regras, depois a versão aleatorizada
+    bool divisao;        // Volta gigante + divisão ótima: a do guloso, depois as do GRASP
+    bool economias;      // Clarke e Wright (uma construção, determinística)
+    double tempo_limite; // Segundos por instância (0 = sem limite de tempo)
+    int tamanho_lrc;     // Máximo de candidatos sorteados a cada passo
+    double alfa;         // Candidatos a até (1 + alfa) vezes a distância do mais próximo
+    uint64_t semente;    // Semente mestre; a construção k usa uma semente derivada dela e de k
+
+    OpcoesGrasp() : inicios(0), varredura(false), divisao(false), economias(false), tempo_limite(0), tamanho_lrc(3), alfa(0.1), semente(1) {}
+
+    bool ativo() const { return inicios > 1 || tempo_limite > 0 || varredura || divisao || economias; }
+};
+
+// Opções de execução de uma etapa sobre um conjunto de instâncias
+struct OpcoesLote
+{
+    string entrada;              // Instâncias: diretório, arquivo ou padrão (* e ?) no nome do arquivo
+    string diretorio_saida;      // Soluções das Etapas 2 e 3 (vazio = padrão da etapa)
+    string diretorio_resultados; // Onde gravar os CSVs
+    string diretorio_iniciais;   // Soluções da Etapa 2, ponto de partida da Etapa 3
+    string diretorio_melhores;   // Melhores soluções conhecidas (Etapa 3)
+    bool reconstruir;            // Etapa 3 constrói a solução inicial em vez de partir das guardadas
+    int num_jobs;                // Instâncias resolvidas ao mesmo tempo
+    OpcoesGrasp grasp;           // Construção das soluções iniciais (Etapas 2 e 3, pipeline)
+
+    OpcoesLote()
+        : entrada("./dados/*.dat"), diretorio_resultados("."), diretorio_iniciais("./solucao/"),
+          diretorio_melhores("./melhores_solucoes/"), reconstruir(false), num_jobs(1)
+    {
+    }
+};
+
+// Instâncias que casam com o padrão, sem os arquivos de solução (sol-*), em
+// ordem de nome. Lança runtime_error se o diretório não existir.
+vector<string> listarInstancias(const string &padrao);
+
+// Custo relativo estimado de uma instância na etapa, a partir só do cabeçalho
+double estimarCustoInstancia(const string &caminho_arquivo, int etapa);
+
+// Chama processar(i) para cada instância em num_jobs threads, começando pelas
+// de maior custo estimado (evita que as maiores fiquem para o fim). A ordem de
+// término é arbitrária: os resultados devem ser guardados pelo índice i.
+void processarInstancias(const vector<string> &instancias, int etapa, int num_jobs,
+                         const function<void(size_t)> &processar);
+
+// Modo sem menu. Retorna o código de saída do programa.
+int executarLinhaDeComando(int argc, char *argv[]);
+
+#endif // LOTE_H
@@ -0,0 +1,135 @@
+#include "pipeline.h"
+#include "etapa1.h"
+#include "etapa2.h"
+#include "etapa3.h"
+#include "../core/registro.h"
+#include <filesystem>
+#include <atomic>
+
+namespace fs = std::filesystem;
+
+bool executarPipeline(const OpcoesLote &opcoes)
+{
+    REGISTRO_INFO("Iniciando Pipeline - Etapas 1, 2 e 3 com uma leitura por instância");
+
+    clock_t inicio = clock();
+
+    string diretorio_iniciais = (fs::path(opcoes.diretorio_iniciais) / "").string();
+    string diretorio_otimizadas =
+        (fs::path(opcoes.diretorio_saida.empty() ? "./solucao_otimizada/" : opcoes.diretorio_saida) / "").string();
+    fs::create_directories(diretorio_iniciais);
+    fs::create_directories(diretorio_otimizadas);
+
+    REGISTRO_INFO("Buscando arquivos .dat em: " << opcoes.entrada);
+    REGISTRO_INFO("Soluções iniciais em: " << diretorio_iniciais);
+    REGISTRO_INFO("Soluções otimizadas em: " << diretorio_otimizadas);
+
+    vector<string> instancias = listarInstancias(opcoes.entrada);
+    int total_instancias = instancias.size();
+    if (total_instancias == 0)
+    {
+        REGISTRO_ERRO("Nenhum arquivo .dat encontrado para: " << opcoes.entrada);
+        return false;
+    }
+
+    REGISTRO_INFO("Total de instâncias a processar: " << total_instancias);
+
+    MelhoresSolucoes melhores(opcoes.diretorio_melhores);
+
+    // Resultados por índice de instância: os CSVs saem na ordem de nome
+    vector<MetricasGrafo> metricas(total_instancias);
+    vector<EstatisticasOtimizacao> estatisticas(total_instancias);
+    vector<char> processado(total_instancias, 0);
+    vector<char> com_metricas(total_instancias, 0);
+    atomic<int> instancias_iniciadas(0);
+
+    // O custo é dominado pelos caminhos mínimos de todos os pares, como na Etapa 1
+    processarInstancias(instancias, 1, opcoes.num_jobs, [&](size_t i)
+    {
+        string nome_arquivo = fs::path(instancias[i]).filename().string();
+
+        REGISTRO_INFO("\n===================================================");
+        REGISTRO_INFO("Processando instância " << ++instancias_iniciadas << "/" << total_instancias
+                      << ": " << nome_arquivo);
+        REGISTRO_INFO("===================================================");
+
+        try
+        {
+            // Uma leitura completa atende as três etapas
+            Grafo grafo_leitura;
+            grafo_leitura.lerArquivoDados(instancias[i]);
+            const Grafo &grafo = grafo_leitura;
+
+            // Etapa 1: uma falha nas métricas (custos que a intermediação não
+            // aceita, por exemplo) não impede as Etapas 2 e 3
+            try
+            {
+                metricas[i] = calcularMetricasGrafo(grafo);
+                com_metricas[i] = 1;
+            }
+            catch (const exception &e)
+            {
+                REGISTRO_ERRO("✗ Métricas de " << nome_arquivo << " não calculadas: " << e.what());
+            }
+
+            // Etapa 2
+            Solucao solucao = construirSolucao(grafo, inicio, opcoes.grasp);
+            salvarSolucao(nome_arquivo, solucao, diretorio_iniciais, grafo);
+
+            // Etapa 3: parte da melhor solução conhecida, como executarEtapa3;
+            // na falta dela, da solução que a Etapa 2 acabou de gravar
+            Solucao partida;
+            if (opcoes.reconstruir || !melhores.obter(nome_arquivo, grafo, partida))
+            {
+                partida = solucao;
+            }
+            partida.tempo_execucao = clock() - inicio;
+            SolucaoOtimizada solucao_otimizada =
+                otimizarInstancia(grafo, nome_arquivo, partida, diretorio_otimizadas, melhores);
+
+            estatisticas[i] = solucao_otimizada.estatisticas;
+            processado[i] = 1;
+        }
+        catch (const exception &e)
+        {
+            REGISTRO_ERRO("✗ Erro ao processar instância " << nome_arquivo << ": " << e.what());
+        }
+    });
+
+    vector<MetricasGrafo> todas_metricas;
+    vector<pair<string, EstatisticasOtimizacao>> todas_estatisticas;
+    int instancias_sucesso = 0;
+    for (int i = 0; i < total_instancias; i++)
+    {
+        if (com_metricas[i])
+        {
+            todas_metricas.push_back(move(metricas[i]));
+        }
+        if (processado[i])
+        {
+            todas_estatisticas.push_back({fs::path(instancias[i]).filename().string(), estatisticas[i]});
+        }
+        instancias_sucesso += com_metricas[i] && processado[i];
+    }
+
+    if (!todas_metricas.empty() || !todas_estatisticas.empty())
+    {
+        REGISTRO_INFO("\nExportando resultados...");
+    }
+    if (!todas_metricas.empty())
+    {
+        exportarParaCSV(todas_metricas, opcoes.diretorio_resultados);
+    }
+    if (!todas_estatisticas.empty())
+    {
+        exportarEstatisticasOtimizacao(todas_estatisticas, opcoes.diretorio_resultados);
+    }
+
+    clock_t tempo_total = clock() - inicio;
+
+    REGISTRO_INFO("\n=== PIPELINE CONCLUÍDO ===");
+    REGISTRO_INFO("Total processado: " << instancias_sucesso << "/" << total_instancias);
+    REGISTRO_INFO("Tempo total: " << tempo_total << " clocks ("
+                  << static_cast<double>(tempo_total) / CLOCKS_PER_SEC << " segundos)");
+    return instancias_sucesso == total_instancias;
+}
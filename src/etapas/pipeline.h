@@ -0,0 +1,16 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "lote.h"
+
+using namespace std;
+
+// Etapas 1, 2 e 3 em sequência com uma única leitura de cada instância: o
+// Grafo (e seus caminhos mínimos) é montado uma vez e usado, somente leitura,
+// pelas métricas, pela construção e pela otimização. Os arquivos gerados são
+// os mesmos das etapas separadas: CSVs em diretorio_resultados, soluções
+// iniciais em diretorio_iniciais e otimizadas em diretorio_saida
+// (./solucao_otimizada/ se vazio). True se todas as instâncias foram processadas.
+bool executarPipeline(const OpcoesLote &opcoes = OpcoesLote());
+
+#endif // PIPELINE_H
@@ -0,0 +1,254 @@
+#include "solucoes.h"
+#include "etapa3.h"
+#include "../io/arquivo_mapeado.h"
+#include "../io/gravacao_atomica.h"
+#include "../io/leitor_arquivo.h"
+#include "../core/registro.h"
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+[[noreturn]] static void erroSolucao(const CursorTexto &cursor, const string &mensagem)
+{
+    throw runtime_error(*cursor.arquivo + ":" + to_string(cursor.linha) + ": " + mensagem);
+}
+
+// Pula espaços, tabulações e vírgulas (separadores dentro das visitas) na linha atual
+static void pularSeparadores(CursorTexto &cursor)
+{
+    while (cursor.atual < cursor.fim &&
+           (*cursor.atual == ' ' || *cursor.atual == '\t' || *cursor.atual == '\r' || *cursor.atual == ','))
+    {
+        cursor.atual++;
+    }
+}
+
+static void pularLinhasEmBranco(CursorTexto &cursor)
+{
+    pularSeparadores(cursor);
+    while (cursor.atual < cursor.fim && *cursor.atual == '\n')
+    {
+        cursor.atual++;
+        cursor.linha++;
+        pularSeparadores(cursor);
+    }
+}
+
+static bool fimDaLinha(CursorTexto &cursor)
+{
+    pularSeparadores(cursor);
+    return cursor.atual == cursor.fim || *cursor.atual == '\n';
+}
+
+static long long lerNumero(CursorTexto &cursor, const char *campo)
+{
+    pularSeparadores(cursor);
+    long long valor = 0;
+    auto [fim_numero, codigo] = from_chars(cursor.atual, cursor.fim, valor);
+    if (codigo != errc())
+    {
+        erroSolucao(cursor, string("esperado inteiro em ") + campo);
+    }
+    cursor.atual = fim_numero;
+    return valor;
+}
+
+static void esperar(CursorTexto &cursor, char caractere)
+{
+    pularSeparadores(cursor);
+    if (cursor.atual == cursor.fim || *cursor.atual != caractere)
+    {
+        erroSolucao(cursor, string("esperado '") + caractere + "'");
+    }
+    cursor.atual++;
+}
+
+static void terminarLinha(CursorTexto &cursor)
+{
+    if (!fimDaLinha(cursor))
+    {
+        erroSolucao(cursor, "conteúdo inesperado no fim da linha");
+    }
+    if (cursor.atual < cursor.fim)
+    {
+        cursor.atual++;
+        cursor.linha++;
+    }
+}
+
+Solucao carregarSolucao(const string &caminho_solucao, const Grafo &grafo)
+{
+    unique_ptr<ArquivoMapeado> arquivo = ArquivoMapeado::mapear(caminho_solucao);
+    if (!arquivo)
+    {
+        throw runtime_error("Erro ao abrir o arquivo de solução: " + caminho_solucao);
+    }
+
+    CursorTexto cursor = {arquivo->dados(), arquivo->dados() + arquivo->bytes(), 1, &caminho_solucao};
+    const vector<Servico> &servicos = grafo.getServicos();
+    vector<char> atendido(servicos.size() + 1, 0);
+
+    // Cabeçalho: custo total, número de rotas, tempo total, tempo até a melhor solução
+    pularLinhasEmBranco(cursor);
+    long long custo_declarado = lerNumero(cursor, "custo total");
+    terminarLinha(cursor);
+    long long rotas_declaradas = lerNumero(cursor, "número de rotas");
+    terminarLinha(cursor);
+    lerNumero(cursor, "tempo total");
+    terminarLinha(cursor);
+    lerNumero(cursor, "tempo da melhor solução");
+    terminarLinha(cursor);
+
+    Solucao solucao;
+    pularLinhasEmBranco(cursor);
+    while (cursor.atual < cursor.fim)
+    {
+        // depósito, dia, id da rota, demanda, custo, número de visitas
+        for (const char *campo : {"depósito da rota", "dia", "id da rota", "demanda", "custo", "visitas"})
+        {
+            lerNumero(cursor, campo);
+        }
+
+        Rota rota;
+        while (!fimDaLinha(cursor))
+        {
+            esperar(cursor, '(');
+            pularSeparadores(cursor);
+            char tipo = cursor.atual < cursor.fim ? *cursor.atual++ : '\0';
+            if (tipo != 'D' && tipo != 'S')
+            {
+                erroSolucao(cursor, "visita deve começar com (D ou (S");
+            }
+            long long id = lerNumero(cursor, "id da visita");
+            long long primeiro = lerNumero(cursor, "extremidade da visita");
+            long long segundo = lerNumero(cursor, "extremidade da visita");
+            esperar(cursor, ')');
+
+            // Passagens pelo depósito no meio da rota não mudam o atendimento e
+            // nunca barateiam o trajeto: são descartadas
+            if (tipo == 'D')
+            {
+                continue;
+            }
+
+            if (id < 1 || id > static_cast<long long>(servicos.size()))
+            {
+                erroSolucao(cursor, "serviço " + to_string(id) + " não existe na instância");
+            }
+            if (atendido[id])
+            {
+                erroSolucao(cursor, "serviço " + to_string(id) + " atendido mais de uma vez");
+            }
+            const Servico &servico = servicos[id - 1];
+            bool sentido_direto = primeiro == servico.origem && segundo == servico.destino;
+            bool sentido_inverso = primeiro == servico.destino && segundo == servico.origem;
+            if (!sentido_direto && !(servico.tipo == 'E' && sentido_inverso))
+            {
+                erroSolucao(cursor, "extremidades (" + to_string(primeiro) + "," + to_string(segundo) +
+                                        ") não correspondem ao serviço " + to_string(id));
+            }
+            atendido[id] = 1;
+            rota.nos.push_back({static_cast<int>(id), static_cast<int>(primeiro)});
+            rota.demanda_total += servico.demanda;
+        }
+
+        if (rota.demanda_total > grafo.getCapacidade())
+        {
+            erroSolucao(cursor, "rota com demanda " + to_string(rota.demanda_total) + " acima da capacidade");
+        }
+        if (!rota.nos.empty())
+        {
+            rota.custo_total = calcularCustoRota(grafo, rota);
+            solucao.custo_total += rota.custo_total;
+            solucao.rotas.push_back(move(rota));
+        }
+        terminarLinha(cursor);
+        pularLinhasEmBranco(cursor);
+    }
+
+    for (size_t id = 1; id < atendido.size(); id++)
+    {
+        if (!atendido[id])
+        {
+            throw runtime_error(caminho_solucao + ": serviço " + to_string(id) + " não é atendido");
+        }
+    }
+
+    solucao.num_rotas = solucao.rotas.size();
+    if (custo_declarado != solucao.custo_total || rotas_declaradas != solucao.num_rotas)
+    {
+        REGISTRO_DEPURACAO(caminho_solucao << ": cabeçalho declara custo " << custo_declarado << " e "
+                           << rotas_declaradas << " rotas; recalculado: " << solucao.custo_total << " e "
+                           << solucao.num_rotas);
+    }
+    return solucao;
+}
+
+MelhoresSolucoes::MelhoresSolucoes(const string &diretorio) : diretorio(diretorio)
+{
+}
+
+string MelhoresSolucoes::caminhoPara(const string &nome_instancia) const
+{
+    return (fs::path(diretorio) / ("sol-" + nome_instancia)).string();
+}
+
+bool MelhoresSolucoes::obter(const string &nome_instancia, const Grafo &grafo, Solucao &solucao) const
+{
+    string caminho = caminhoPara(nome_instancia);
+    if (!fs::exists(caminho))
+    {
+        return false;
+    }
+
+    try
+    {
+        solucao = carregarSolucao(caminho, grafo);
+        return true;
+    }
+    catch (const exception &e)
+    {
+        // Arquivo de outra versão da instância ou corrompido: será substituído
+        REGISTRO_AVISO("Melhor solução guardada ignorada: " << e.what());
+        return false;
+    }
+}
+
+bool MelhoresSolucoes::atualizar(const string &nome_instancia, const Solucao &solucao, const Grafo &grafo) const
+{
+    string caminho = caminhoPara(nome_instancia);
+    if (fs::exists(caminho))
+    {
+        try
+        {
+            if (carregarSolucao(caminho, grafo).custo_total <= solucao.custo_total)
+            {
+                return false;
+            }
+        }
+        catch (const exception &)
+        {
+            // Guardada inválida (já avisado em obter): é substituída
+        }
+    }
+
+    error_code erro;
+    fs::create_directories(diretorio, erro);
+    if (erro)
+    {
+        REGISTRO_AVISO("Não foi possível criar o diretório de melhores soluções: " << diretorio);
+        return false;
+    }
+
+    // Temporário + rename: quem lê nunca vê um arquivo parcial
+    if (!gravarArquivoAtomico(caminho, [&](ostream &arquivo)
+                              { escreverSolucao(arquivo, solucao, solucao.tempo_execucao, grafo); }))
+    {
+        REGISTRO_AVISO("Erro ao gravar a melhor solução: " << caminho);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef SOLUCOES_H
+#define SOLUCOES_H
+
+#include "../core/grafo.h"
+#include "etapa2.h"
+#include <string>
+
+using namespace std;
+
+// Lê um arquivo sol-*.dat (formato de escreverSolucao) e reconstrói a solução
+// para o grafo. Demandas e custos das rotas são recalculados; visitas
+// intermediárias ao depósito são descartadas. Lança runtime_error
+// ("<arquivo>:<linha>: mensagem") se o arquivo não corresponder à instância:
+// serviço inexistente, repetido ou não atendido, extremidades que não são as do
+// serviço ou rota acima da capacidade.
+Solucao carregarSolucao(const string &caminho_solucao, const Grafo &grafo);
+
+// Melhores soluções conhecidas, uma por instância em <diretorio>/sol-<instancia>.
+// A Etapa 3 parte delas e só as substitui por soluções mais baratas, de modo
+// que execuções repetidas continuam do melhor resultado obtido até então.
+class MelhoresSolucoes
+{
+private:
+    string diretorio;
+
+    string caminhoPara(const string &nome_instancia) const;
+
+public:
+    explicit MelhoresSolucoes(const string &diretorio);
+
+    // false se não houver solução guardada válida para a instância
+    bool obter(const string &nome_instancia, const Grafo &grafo, Solucao &solucao) const;
+
+    // Guarda a solução se não houver uma guardada ou se ela for mais barata.
+    // Retorna true se gravou. A gravação é atômica (temporário + rename).
+    bool atualizar(const string &nome_instancia, const Solucao &solucao, const Grafo &grafo) const;
+};
+
+#endif // SOLUCOES_H
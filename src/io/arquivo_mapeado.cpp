@@ -0,0 +1,72 @@
+#include "arquivo_mapeado.h"
+#include <fstream>
+
+#ifdef __unix__
+#define ARQUIVO_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ArquivoMapeado::~ArquivoMapeado()
+{
+#ifdef ARQUIVO_MMAP
+    if (endereco != nullptr && copia.empty())
+    {
+        munmap(endereco, tamanho);
+    }
+#endif
+}
+
+unique_ptr<ArquivoMapeado> ArquivoMapeado::mapear(const string &caminho)
+{
+    unique_ptr<ArquivoMapeado> arquivo(new ArquivoMapeado());
+
+#ifdef ARQUIVO_MMAP
+    int fd = open(caminho.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    // Arquivo vazio: mmap não aceita tamanho 0, mas é um conteúdo válido
+    if (info.st_size > 0)
+    {
+        void *endereco = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (endereco == MAP_FAILED)
+        {
+            close(fd);
+            return nullptr;
+        }
+        arquivo->endereco = endereco;
+        arquivo->tamanho = info.st_size;
+    }
+    close(fd);
+#else
+    ifstream entrada(caminho, ios::binary | ios::ate);
+    if (!entrada.is_open())
+    {
+        return nullptr;
+    }
+
+    size_t tamanho = static_cast<size_t>(entrada.tellg());
+    arquivo->copia = BufferAlinhado<char>(tamanho, false);
+    entrada.seekg(0);
+    if (!entrada.read(arquivo->copia.data(), tamanho))
+    {
+        return nullptr;
+    }
+    arquivo->endereco = arquivo->copia.data();
+    arquivo->tamanho = tamanho;
+#endif
+
+    return arquivo;
+}
@@ -0,0 +1,36 @@
+#ifndef ARQUIVO_MAPEADO_H
+#define ARQUIVO_MAPEADO_H
+
+#include "../core/matriz.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+// Arquivo inteiro mapeado em memória somente leitura; desfaz o mapeamento ao
+// ser destruído. Fora de sistemas POSIX o conteúdo é lido para um buffer
+// alinhado, com a mesma interface.
+class ArquivoMapeado
+{
+private:
+    void *endereco;
+    size_t tamanho;
+    BufferAlinhado<char> copia; // Só usado sem mmap
+
+    ArquivoMapeado() : endereco(nullptr), tamanho(0) {}
+
+public:
+    ~ArquivoMapeado();
+
+    ArquivoMapeado(const ArquivoMapeado &) = delete;
+    ArquivoMapeado &operator=(const ArquivoMapeado &) = delete;
+
+    // nullptr se o arquivo não puder ser aberto ou lido
+    static unique_ptr<ArquivoMapeado> mapear(const string &caminho);
+
+    const char *dados() const { return static_cast<const char *>(endereco); }
+    size_t bytes() const { return tamanho; }
+};
+
+#endif // ARQUIVO_MAPEADO_H
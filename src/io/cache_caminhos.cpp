@@ -0,0 +1,123 @@
+#include "cache_caminhos.h"
+#include "gravacao_atomica.h"
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static const char IDENTIFICADOR_CACHE[8] = {'G', 'C', 'C', 'A', 'P', 'S', 'P', '\0'};
+static const uint32_t VERSAO_CACHE = 1;
+
+// O cabeçalho ocupa uma página inteira: as tabelas começam alinhadas à página
+// (e portanto a 64 bytes, como exige MatrizDensa)
+static const size_t TAMANHO_CABECALHO = 4096;
+
+struct CabecalhoCache
+{
+    char identificador[8];
+    uint32_t versao;
+    uint32_t bytes_distancia;
+    uint64_t hash;
+    int32_t dimensao;
+    int32_t reservado;
+    uint64_t passo;
+};
+
+static string caminhoCache(const string &diretorio, uint64_t hash, size_t bytes_distancia)
+{
+    ostringstream nome;
+    nome << hex << setw(16) << setfill('0') << hash << "-" << dec << bytes_distancia * 8 << ".apsp";
+    return (fs::path(diretorio) / nome.str()).string();
+}
+
+static void acumularHash(uint64_t &hash, const void *dados, size_t bytes)
+{
+    const unsigned char *p = static_cast<const unsigned char *>(dados);
+    for (size_t i = 0; i < bytes; i++)
+    {
+        hash ^= p[i];
+        hash *= 0x100000001B3ULL;
+    }
+}
+
+uint64_t hashConteudoGrafo(const GrafoCSR &grafo)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    acumularHash(hash, &grafo.num_vertices, sizeof(grafo.num_vertices));
+    acumularHash(hash, grafo.inicio.data(), grafo.inicio.size() * sizeof(int));
+    acumularHash(hash, grafo.destinos.data(), grafo.destinos.size() * sizeof(int));
+    acumularHash(hash, grafo.pesos.data(), grafo.pesos.size() * sizeof(Custo));
+    return hash;
+}
+
+template <typename T>
+bool carregarCacheCaminhos(const string &diretorio, uint64_t hash, int dimensao,
+                           VisaoMatriz<T> &dist, VisaoMatriz<T> &pred, shared_ptr<ArquivoMapeado> &mapeamento)
+{
+    const size_t passo = MatrizDensa<T>::passoPara(dimensao);
+    const size_t bytes_tabela = passo * dimensao * sizeof(T);
+
+    shared_ptr<ArquivoMapeado> mapa = ArquivoMapeado::mapear(caminhoCache(diretorio, hash, sizeof(T)));
+    if (!mapa || mapa->bytes() != TAMANHO_CABECALHO + 2 * bytes_tabela)
+    {
+        return false;
+    }
+
+    CabecalhoCache cabecalho;
+    memcpy(&cabecalho, mapa->dados(), sizeof(cabecalho));
+    if (memcmp(cabecalho.identificador, IDENTIFICADOR_CACHE, sizeof(IDENTIFICADOR_CACHE)) != 0 ||
+        cabecalho.versao != VERSAO_CACHE || cabecalho.bytes_distancia != sizeof(T) || cabecalho.hash != hash ||
+        cabecalho.dimensao != dimensao || cabecalho.passo != passo)
+    {
+        return false;
+    }
+
+    const T *tabelas = reinterpret_cast<const T *>(mapa->dados() + TAMANHO_CABECALHO);
+    dist = VisaoMatriz<T>(tabelas, dimensao, dimensao);
+    pred = VisaoMatriz<T>(tabelas + passo * dimensao, dimensao, dimensao);
+    mapeamento = move(mapa);
+    return true;
+}
+
+template <typename T>
+bool salvarCacheCaminhos(const string &diretorio, uint64_t hash, const MatrizDensa<T> &dist,
+                         const MatrizDensa<T> &pred)
+{
+    error_code erro;
+    fs::create_directories(diretorio, erro);
+    if (erro)
+    {
+        return false;
+    }
+
+    CabecalhoCache cabecalho = {};
+    memcpy(cabecalho.identificador, IDENTIFICADOR_CACHE, sizeof(IDENTIFICADOR_CACHE));
+    cabecalho.versao = VERSAO_CACHE;
+    cabecalho.bytes_distancia = sizeof(T);
+    cabecalho.hash = hash;
+    cabecalho.dimensao = dist.getLinhas();
+    cabecalho.passo = dist.getPasso();
+
+    vector<char> pagina(TAMANHO_CABECALHO, 0);
+    memcpy(pagina.data(), &cabecalho, sizeof(cabecalho));
+
+    // Temporário + rename: leitores nunca veem um arquivo parcial
+    return gravarArquivoAtomico(caminhoCache(diretorio, hash, sizeof(T)), [&](ostream &arquivo)
+    {
+        arquivo.write(pagina.data(), pagina.size());
+        arquivo.write(reinterpret_cast<const char *>(dist.data()), dist.tamanho() * sizeof(T));
+        arquivo.write(reinterpret_cast<const char *>(pred.data()), pred.tamanho() * sizeof(T));
+    }, true);
+}
+
+template bool carregarCacheCaminhos<int32_t>(const string &, uint64_t, int, VisaoMatriz<int32_t> &,
+                                             VisaoMatriz<int32_t> &, shared_ptr<ArquivoMapeado> &);
+template bool carregarCacheCaminhos<int16_t>(const string &, uint64_t, int, VisaoMatriz<int16_t> &,
+                                             VisaoMatriz<int16_t> &, shared_ptr<ArquivoMapeado> &);
+template bool salvarCacheCaminhos<int32_t>(const string &, uint64_t, const MatrizDensa<int32_t> &,
+                                           const MatrizDensa<int32_t> &);
+template bool salvarCacheCaminhos<int16_t>(const string &, uint64_t, const MatrizDensa<int16_t> &,
+                                           const MatrizDensa<int16_t> &);
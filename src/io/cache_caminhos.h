@@ -0,0 +1,42 @@
+#ifndef CACHE_CAMINHOS_H
+#define CACHE_CAMINHOS_H
+
+#include "../core/matriz.h"
+#include "../core/grafo_csr.h"
+#include "arquivo_mapeado.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+// Cache em disco das matrizes de caminhos mínimos (modo COMPLETA).
+//
+// Cada arquivo <diretorio>/<hash>-<bits>.apsp contém um cabeçalho de uma página
+// (identificador, versão, hash do conteúdo do grafo, número de vértices, largura
+// das distâncias) seguido das tabelas de distâncias e de predecessores já no
+// layout de MatrizDensa. Na leitura o arquivo é mapeado somente leitura e as
+// tabelas são devolvidas como VisaoMatriz sobre ele: nada é copiado nem
+// recalculado, e escrever nelas nem compila.
+//
+// A chave é o hash da adjacência compacta (vértices, ligações e custos), não
+// do texto do arquivo: instâncias iguais compartilham o cache e qualquer
+// mudança no grafo lido (inclusive por correções no leitor) gera outra chave.
+
+// Hash FNV-1a de 64 bits do conteúdo do grafo
+uint64_t hashConteudoGrafo(const GrafoCSR &grafo);
+
+// Mapeia o cache correspondente e devolve dist/pred (dimensao x dimensao) como
+// visões sobre ele. Retorna false (sem alterar as visões) se não houver
+// arquivo válido. O mapeamento deve viver enquanto as visões forem usadas.
+template <typename T>
+bool carregarCacheCaminhos(const string &diretorio, uint64_t hash, int dimensao,
+                           VisaoMatriz<T> &dist, VisaoMatriz<T> &pred, shared_ptr<ArquivoMapeado> &mapeamento);
+
+// Grava as matrizes no cache (arquivo temporário + rename, seguro com vários
+// processos gravando a mesma instância). Retorna false em caso de erro de E/S.
+template <typename T>
+bool salvarCacheCaminhos(const string &diretorio, uint64_t hash, const MatrizDensa<T> &dist,
+                         const MatrizDensa<T> &pred);
+
+#endif // CACHE_CAMINHOS_H
@@ -6,6 +6,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include "../core/grafo_csr.h"
 
 using namespace std;
 
@@ -29,7 +30,7 @@ struct DadosGrafo
     set<int> vertices;
     vector<pair<int, int>> arestas;
     vector<pair<int, int>> arcos;
-    map<int, vector<pair<int, double>>> adj;
+    GrafoCSR adjacencia; // Ligações de saída de cada vértice (arestas nos dois sentidos)
     
     // Elementos requeridos
     set<int> vertices_requeridos;
@@ -50,4 +51,15 @@ struct DadosGrafo
     DadosGrafo() : num_vertices(0), valor_otimo(-1), num_veiculos(-1), capacidade(0), deposito(0) {}
 };
 
+// Contagens do cabeçalho de uma instância (para estimar seu custo sem lê-la inteira)
+struct ResumoInstancia
+{
+    int num_vertices;
+    int num_arestas;
+    int num_arcos;
+    int num_vertices_requeridos;
+    int num_arestas_requeridas;
+    int num_arcos_requeridos;
+};
+
 #endif // ESTRUTURAS_GRAFO_H
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "gravacao_atomica.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+bool gravarArquivoAtomico(const string &caminho, const function<void(ostream &)> &escrever, bool binario)
+{
+    static atomic<unsigned> gravacoes(0);
+#ifdef __unix__
+    string temporario = caminho + ".tmp" + to_string(getpid()) + "-" + to_string(gravacoes++);
+#else
+    string temporario = caminho + ".tmp" + to_string(gravacoes++);
+#endif
+
+    error_code erro;
+    {
+        ofstream arquivo(temporario, binario ? ios::binary | ios::trunc : ios::trunc);
+        escrever(arquivo);
+        if (!arquivo)
+        {
+            arquivo.close();
+            fs::remove(temporario, erro);
+            return false;
+        }
+    }
+
+    fs::rename(temporario, caminho, erro);
+    if (erro)
+    {
+        fs::remove(temporario, erro);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,16 @@
+#ifndef GRAVACAO_ATOMICA_H
+#define GRAVACAO_ATOMICA_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+
+using namespace std;
+
+// Grava caminho com escrever(arquivo) em um temporário exclusivo (por processo
+// e por gravação) e renomeia ao final: quem lê nunca vê um arquivo parcial,
+// mesmo com vários processos gravando o mesmo caminho. Retorna false, sem
+// deixar o temporário, se a escrita ou o rename falhar.
+bool gravarArquivoAtomico(const string &caminho, const function<void(ostream &)> &escrever, bool binario = false);
+
+#endif // GRAVACAO_ATOMICA_H
@@ -1,122 +1,204 @@
 #include "leitor_arquivo.h"
-#include <iostream>
+#include "arquivo_mapeado.h"
+#include "../core/registro.h"
+#include <charconv>
+#include <stdexcept>
 
 DadosGrafo LeitorArquivo::lerArquivoDados(const string &nome_arquivo)
 {
     DadosGrafo dados;
-    
-    cout << "Lendo arquivo: " << nome_arquivo << endl;
-    
-    ifstream arquivo(nome_arquivo);
-    if (!arquivo.is_open())
+
+    REGISTRO_DEPURACAO("Lendo arquivo: " << nome_arquivo);
+
+    unique_ptr<ArquivoMapeado> arquivo = ArquivoMapeado::mapear(nome_arquivo);
+    if (!arquivo)
     {
-        cerr << "Erro ao abrir o arquivo: " << nome_arquivo << endl;
-        return dados;
+        throw runtime_error("Erro ao abrir o arquivo: " + nome_arquivo);
     }
 
+    CursorTexto cursor = {arquivo->dados(), arquivo->dados() + arquivo->bytes(), 1, &nome_arquivo};
+
     int id_servico = 1;
+    int num_arestas, num_arcos;
     int num_vertices_requeridos, num_arestas_requeridas, num_arcos_requeridos;
-    
-    lerCabecalho(arquivo, dados);
-    lerQuantidadesRequeridas(arquivo, num_vertices_requeridos, num_arestas_requeridas, num_arcos_requeridos);
+
+    lerCabecalho(cursor, dados, num_arestas, num_arcos);
+    lerQuantidadesRequeridas(cursor, num_vertices_requeridos, num_arestas_requeridas, num_arcos_requeridos);
+    if (num_arestas_requeridas > num_arestas || num_arcos_requeridos > num_arcos)
+    {
+        erro(cursor, "mais arestas/arcos requeridos do que o total declarado no cabeçalho");
+    }
     inicializarVertices(dados);
-    
-    lerNosRequeridos(arquivo, dados, num_vertices_requeridos, id_servico);
-    lerArestasRequeridas(arquivo, dados, num_arestas_requeridas, id_servico);
-    lerArestasNaoRequeridas(arquivo, dados);
-    lerArcosRequeridos(arquivo, dados, num_arcos_requeridos, id_servico);
-    lerArcosNaoRequeridos(arquivo, dados);
-    
-    arquivo.close();
-    
-    cout << "Leitura do arquivo concluída." << endl;
-    cout << "Total de serviços: " << dados.servicos.size() << endl;
-    
+
+    // Tudo dimensionado pelo cabeçalho: nenhuma realocação durante a leitura
+    vector<LigacaoCSR> ligacoes; // Na ordem do arquivo; viram a adjacência compacta ao final
+    ligacoes.reserve(2 * static_cast<size_t>(num_arestas) + num_arcos);
+    dados.arestas.reserve(num_arestas);
+    dados.arcos.reserve(num_arcos);
+    dados.servicos.reserve(num_vertices_requeridos + num_arestas_requeridas + num_arcos_requeridos);
+
+    lerNosRequeridos(cursor, dados, num_vertices_requeridos, id_servico);
+    lerArestasRequeridas(cursor, dados, ligacoes, num_arestas_requeridas, id_servico);
+    lerArestasNaoRequeridas(cursor, dados, ligacoes, num_arestas - num_arestas_requeridas);
+    lerArcosRequeridos(cursor, dados, ligacoes, num_arcos_requeridos, id_servico);
+    lerArcosNaoRequeridos(cursor, dados, ligacoes, num_arcos - num_arcos_requeridos);
+    // O que vier depois da seção ARC (comentários sobre a origem da instância) é ignorado
+
+    dados.adjacencia = GrafoCSR::construir(dados.num_vertices, ligacoes);
+
+    REGISTRO_DEPURACAO("Leitura do arquivo concluída.");
+    REGISTRO_DEPURACAO("Total de serviços: " << dados.servicos.size());
+
     return dados;
 }
 
-void LeitorArquivo::lerCabecalho(ifstream &arquivo, DadosGrafo &dados)
+ResumoInstancia LeitorArquivo::lerResumoInstancia(const string &nome_arquivo)
 {
-    string linha;
-    
-    // Nome da instância
-    getline(arquivo, linha);
-    dados.nome = linha.substr(linha.find_first_of(":") + 1);
-    dados.nome = dados.nome.substr(dados.nome.find_first_not_of(" \t"));
-    cout << "Nome da instância: " << dados.nome << endl;
-
-    // Valor ótimo
-    getline(arquivo, linha);
-    dados.valor_otimo = stoi(linha.substr(linha.find_first_of(":") + 1));
-
-    // Número de veículos
-    getline(arquivo, linha);
-    dados.num_veiculos = stoi(linha.substr(linha.find_first_of(":") + 1));
-
-    // Capacidade
-    getline(arquivo, linha);
-    dados.capacidade = stoi(linha.substr(linha.find_first_of(":") + 1));
-    cout << "Capacidade: " << dados.capacidade << endl;
-
-    // Depósito
-    getline(arquivo, linha);
-    dados.deposito = stoi(linha.substr(linha.find_first_of(":") + 1));
-    cout << "Depósito: " << dados.deposito << endl;
-
-    // Número de nós
-    getline(arquivo, linha);
-    dados.num_vertices = stoi(linha.substr(linha.find_first_of(":") + 1));
-    cout << "Número de vértices: " << dados.num_vertices << endl;
-
-    // Pular número de arestas e arcos (não usados diretamente)
-    getline(arquivo, linha); // num_arestas
-    getline(arquivo, linha); // num_arcos
+    unique_ptr<ArquivoMapeado> arquivo = ArquivoMapeado::mapear(nome_arquivo);
+    if (!arquivo)
+    {
+        throw runtime_error("Erro ao abrir o arquivo: " + nome_arquivo);
+    }
+
+    CursorTexto cursor = {arquivo->dados(), arquivo->dados() + arquivo->bytes(), 1, &nome_arquivo};
+    DadosGrafo dados;
+    ResumoInstancia resumo;
+    lerCabecalho(cursor, dados, resumo.num_arestas, resumo.num_arcos);
+    lerQuantidadesRequeridas(cursor, resumo.num_vertices_requeridos, resumo.num_arestas_requeridas,
+                             resumo.num_arcos_requeridos);
+    resumo.num_vertices = dados.num_vertices;
+    return resumo;
 }
 
-void LeitorArquivo::lerQuantidadesRequeridas(ifstream &arquivo, int &num_vertices_req, 
+void LeitorArquivo::lerCabecalho(CursorTexto &cursor, DadosGrafo &dados, int &num_arestas, int &num_arcos)
+{
+    // Nome da instância: o resto da linha, sem espaços nas pontas
+    lerRotulo(cursor, "Name");
+    const char *inicio = cursor.atual;
+    while (cursor.atual < cursor.fim && *cursor.atual != '\n')
+    {
+        cursor.atual++;
+    }
+    const char *fim = cursor.atual;
+    while (fim > inicio && (fim[-1] == ' ' || fim[-1] == '\t' || fim[-1] == '\r'))
+    {
+        fim--;
+    }
+    if (fim == inicio)
+    {
+        erro(cursor, "nome da instância vazio");
+    }
+    dados.nome.assign(inicio, fim);
+    pularLinha(cursor);
+    REGISTRO_DEPURACAO("Nome da instância: " << dados.nome);
+
+    lerRotulo(cursor, "Optimal value");
+    dados.valor_otimo = lerInteiro(cursor, "Optimal value");
+    terminarLinha(cursor);
+
+    lerRotulo(cursor, "#Vehicles");
+    dados.num_veiculos = lerInteiro(cursor, "#Vehicles");
+    terminarLinha(cursor);
+
+    lerRotulo(cursor, "Capacity");
+    dados.capacidade = lerInteiro(cursor, "Capacity");
+    terminarLinha(cursor);
+    REGISTRO_DEPURACAO("Capacidade: " << dados.capacidade);
+
+    lerRotulo(cursor, "Depot Node");
+    CursorTexto cursor_deposito = cursor; // O intervalo só é conferido depois de #Nodes
+    dados.deposito = lerInteiro(cursor, "Depot Node");
+    terminarLinha(cursor);
+    REGISTRO_DEPURACAO("Depósito: " << dados.deposito);
+
+    lerRotulo(cursor, "#Nodes");
+    dados.num_vertices = lerInteiro(cursor, "#Nodes");
+    terminarLinha(cursor);
+    if (dados.num_vertices <= 0)
+    {
+        erro(cursor, "número de vértices deve ser positivo");
+    }
+    if (dados.deposito < 1 || dados.deposito > dados.num_vertices)
+    {
+        erro(cursor_deposito,
+             "vértice " + to_string(dados.deposito) + " fora do intervalo 1.." + to_string(dados.num_vertices));
+    }
+    REGISTRO_DEPURACAO("Número de vértices: " << dados.num_vertices);
+
+    lerRotulo(cursor, "#Edges");
+    num_arestas = lerInteiro(cursor, "#Edges");
+    terminarLinha(cursor);
+
+    lerRotulo(cursor, "#Arcs");
+    num_arcos = lerInteiro(cursor, "#Arcs");
+    terminarLinha(cursor);
+
+    if (num_arestas < 0 || num_arcos < 0)
+    {
+        erro(cursor, "número de arestas e de arcos não pode ser negativo");
+    }
+}
+
+void LeitorArquivo::lerQuantidadesRequeridas(CursorTexto &cursor, int &num_vertices_req,
                                             int &num_arestas_req, int &num_arcos_req)
 {
-    string linha;
-    
-    getline(arquivo, linha);
-    num_vertices_req = stoi(linha.substr(linha.find_first_of(":") + 1));
-    
-    getline(arquivo, linha);
-    num_arestas_req = stoi(linha.substr(linha.find_first_of(":") + 1));
-    
-    getline(arquivo, linha);
-    num_arcos_req = stoi(linha.substr(linha.find_first_of(":") + 1));
-    
-    cout << "Requeridos - Nós: " << num_vertices_req 
-         << ", Arestas: " << num_arestas_req 
-         << ", Arcos: " << num_arcos_req << endl;
+    lerRotulo(cursor, "#Required N");
+    num_vertices_req = lerInteiro(cursor, "#Required N");
+    terminarLinha(cursor);
+
+    lerRotulo(cursor, "#Required E");
+    num_arestas_req = lerInteiro(cursor, "#Required E");
+    terminarLinha(cursor);
+
+    lerRotulo(cursor, "#Required A");
+    num_arcos_req = lerInteiro(cursor, "#Required A");
+    terminarLinha(cursor);
+
+    if (num_vertices_req < 0 || num_arestas_req < 0 || num_arcos_req < 0)
+    {
+        erro(cursor, "quantidades requeridas não podem ser negativas");
+    }
+
+    REGISTRO_DEPURACAO("Requeridos - Nós: " << num_vertices_req
+                       << ", Arestas: " << num_arestas_req
+                       << ", Arcos: " << num_arcos_req);
 }
 
 void LeitorArquivo::inicializarVertices(DadosGrafo &dados)
 {
     for (int i = 1; i <= dados.num_vertices; i++)
     {
-        dados.vertices.insert(i);
+        dados.vertices.insert(dados.vertices.end(), i);
     }
 }
 
-void LeitorArquivo::lerNosRequeridos(ifstream &arquivo, DadosGrafo &dados, 
+void LeitorArquivo::lerNosRequeridos(CursorTexto &cursor, DadosGrafo &dados,
                                     int num_vertices_requeridos, int &id_servico)
 {
-    pularAteSecao(arquivo, "ReN.");
-    cout << "Lendo nós requeridos..." << endl;
-    
+    abrirSecao(cursor, "ReN.", num_vertices_requeridos);
+
     for (int i = 0; i < num_vertices_requeridos; i++)
     {
-        string linha;
-        getline(arquivo, linha);
-        stringstream ss(linha);
-        string nome_no;
-        int demanda, custo_servico;
+        pularLinhasEmBranco(cursor);
+
+        // Rótulo N<vértice>
+        string_view rotulo = lerPalavra(cursor);
+        int node = 0;
+        const char *fim_rotulo = rotulo.data() + rotulo.size();
+        if (rotulo.size() < 2 || rotulo[0] != 'N' ||
+            from_chars(rotulo.data() + 1, fim_rotulo, node).ptr != fim_rotulo)
+        {
+            erro(cursor, "esperado nó requerido no formato N<vértice>, encontrado '" + string(rotulo) + "'");
+        }
+        if (node < 1 || node > dados.num_vertices)
+        {
+            erro(cursor, "vértice " + to_string(node) + " fora do intervalo 1.." + to_string(dados.num_vertices));
+        }
 
-        ss >> nome_no >> demanda >> custo_servico;
+        int demanda = lerInteiro(cursor, "DEMAND");
+        int custo_servico = lerInteiro(cursor, "S. COST");
+        terminarLinha(cursor);
 
-        int node = stoi(nome_no.substr(1)); // Remove o 'N'
         dados.vertices_requeridos.insert(node);
 
         // Criar serviço para o nó
@@ -130,32 +212,29 @@ void LeitorArquivo::lerNosRequeridos(ifstream &arquivo, DadosGrafo &dados,
         servico.custo_transporte = 0;
 
         dados.servicos.push_back(servico);
-        cout << "Serviço " << servico.id << ": Nó " << node 
-             << ", Demanda " << demanda << ", Custo " << custo_servico << endl;
     }
 }
 
-void LeitorArquivo::lerArestasRequeridas(ifstream &arquivo, DadosGrafo &dados, 
+void LeitorArquivo::lerArestasRequeridas(CursorTexto &cursor, DadosGrafo &dados, vector<LigacaoCSR> &ligacoes,
                                         int num_arestas_requeridas, int &id_servico)
 {
-    pularAteSecao(arquivo, "ReE.");
-    cout << "Lendo arestas requeridas..." << endl;
-    
+    abrirSecao(cursor, "ReE.", num_arestas_requeridas);
+
     for (int i = 0; i < num_arestas_requeridas; i++)
     {
-        string linha;
-        getline(arquivo, linha);
-        stringstream ss(linha);
-        string edge_name;
-        int u, v;
-        double custo_travessia, demanda, custo_servico;
-
-        ss >> edge_name >> u >> v >> custo_travessia >> demanda >> custo_servico;
+        pularLinhasEmBranco(cursor);
+        lerPalavra(cursor); // Rótulo E<i>
+        int u = lerVertice(cursor, dados, "From N.");
+        int v = lerVertice(cursor, dados, "To N.");
+        int custo_travessia = lerInteiro(cursor, "T. COST");
+        int demanda = lerInteiro(cursor, "DEMAND");
+        int custo_servico = lerInteiro(cursor, "S. COST");
+        terminarLinha(cursor);
 
         dados.arestas.push_back({u, v});
         dados.arestas_requeridas.insert({u, v});
-        dados.adj[u].push_back({v, custo_travessia});
-        dados.adj[v].push_back({u, custo_travessia});
+        ligacoes.push_back({u, v, custo_travessia});
+        ligacoes.push_back({v, u, custo_travessia});
 
         // Criar serviço para a aresta
         Servico servico;
@@ -168,65 +247,48 @@ void LeitorArquivo::lerArestasRequeridas(ifstream &arquivo, DadosGrafo &dados,
         servico.custo_transporte = custo_travessia;
 
         dados.servicos.push_back(servico);
-        cout << "Serviço " << servico.id << ": Aresta (" << u << "," << v 
-             << "), Demanda " << demanda << ", Custo " << custo_servico << endl;
     }
 }
 
-void LeitorArquivo::lerArestasNaoRequeridas(ifstream &arquivo, DadosGrafo &dados)
+void LeitorArquivo::lerArestasNaoRequeridas(CursorTexto &cursor, DadosGrafo &dados, vector<LigacaoCSR> &ligacoes,
+                                           int num_arestas_nao_requeridas)
 {
-    pularAteSecao(arquivo, "EDGE");
-    cout << "Lendo arestas não requeridas..." << endl;
-    
-    string linha;
-    getline(arquivo, linha); // Pular linha em branco
-    
-    while (getline(arquivo, linha) && !linha.empty() && linha.find("ReA.") == string::npos)
-    {
-        if (linha.find_first_not_of(" \t\n\r") == string::npos)
-        {
-            continue;
-        }
+    abrirSecao(cursor, "EDGE", num_arestas_nao_requeridas);
 
-        stringstream ss(linha);
-        string edge_name;
-        int u, v;
-        double custo_travessia;
-
-        ss >> edge_name >> u >> v >> custo_travessia;
+    for (int i = 0; i < num_arestas_nao_requeridas; i++)
+    {
+        pularLinhasEmBranco(cursor);
+        lerPalavra(cursor); // Rótulo NrE<i>
+        int u = lerVertice(cursor, dados, "FROM N.");
+        int v = lerVertice(cursor, dados, "TO N.");
+        int custo_travessia = lerInteiro(cursor, "T. COST");
+        terminarLinha(cursor);
 
         dados.arestas.push_back({u, v});
-        dados.adj[u].push_back({v, custo_travessia});
-        dados.adj[v].push_back({u, custo_travessia});
-    }
-
-    // Se encontrou ReA, precisa retroceder uma linha no arquivo
-    if (!linha.empty() && linha.find("ReA.") != string::npos)
-    {
-        arquivo.seekg(-linha.length() - 1, ios_base::cur);
+        ligacoes.push_back({u, v, custo_travessia});
+        ligacoes.push_back({v, u, custo_travessia});
     }
 }
 
-void LeitorArquivo::lerArcosRequeridos(ifstream &arquivo, DadosGrafo &dados, 
+void LeitorArquivo::lerArcosRequeridos(CursorTexto &cursor, DadosGrafo &dados, vector<LigacaoCSR> &ligacoes,
                                       int num_arcos_requeridos, int &id_servico)
 {
-    pularAteSecao(arquivo, "ReA.");
-    cout << "Lendo arcos requeridos..." << endl;
-    
+    abrirSecao(cursor, "ReA.", num_arcos_requeridos);
+
     for (int i = 0; i < num_arcos_requeridos; i++)
     {
-        string linha;
-        getline(arquivo, linha);
-        stringstream ss(linha);
-        string arc_name;
-        int u, v;
-        double custo_travessia, demanda, custo_servico;
-
-        ss >> arc_name >> u >> v >> custo_travessia >> demanda >> custo_servico;
+        pularLinhasEmBranco(cursor);
+        lerPalavra(cursor); // Rótulo A<i>
+        int u = lerVertice(cursor, dados, "FROM N.");
+        int v = lerVertice(cursor, dados, "TO N.");
+        int custo_travessia = lerInteiro(cursor, "T. COST");
+        int demanda = lerInteiro(cursor, "DEMAND");
+        int custo_servico = lerInteiro(cursor, "S. COST");
+        terminarLinha(cursor);
 
         dados.arcos.push_back({u, v});
         dados.arcos_requeridos.insert({u, v});
-        dados.adj[u].push_back({v, custo_travessia});
+        ligacoes.push_back({u, v, custo_travessia});
 
         // Criar serviço para o arco
         Servico servico;
@@ -239,44 +301,157 @@ void LeitorArquivo::lerArcosRequeridos(ifstream &arquivo, DadosGrafo &dados,
         servico.custo_transporte = custo_travessia;
 
         dados.servicos.push_back(servico);
-        cout << "Serviço " << servico.id << ": Arco (" << u << "," << v 
-             << "), Demanda " << demanda << ", Custo " << custo_servico << endl;
     }
 }
 
-void LeitorArquivo::lerArcosNaoRequeridos(ifstream &arquivo, DadosGrafo &dados)
+void LeitorArquivo::lerArcosNaoRequeridos(CursorTexto &cursor, DadosGrafo &dados, vector<LigacaoCSR> &ligacoes,
+                                         int num_arcos_nao_requeridos)
+{
+    abrirSecao(cursor, "ARC", num_arcos_nao_requeridos);
+
+    for (int i = 0; i < num_arcos_nao_requeridos; i++)
+    {
+        pularLinhasEmBranco(cursor);
+        lerPalavra(cursor); // Rótulo NrA<i>
+        int u = lerVertice(cursor, dados, "FROM N.");
+        int v = lerVertice(cursor, dados, "TO N.");
+        int custo_travessia = lerInteiro(cursor, "T. COST");
+        terminarLinha(cursor);
+
+        dados.arcos.push_back({u, v});
+        ligacoes.push_back({u, v, custo_travessia});
+    }
+}
+
+// Consome a linha de título da seção. Seções vazias podem ser omitidas do arquivo
+bool LeitorArquivo::abrirSecao(CursorTexto &cursor, string_view secao, int quantidade)
+{
+    pularLinhasEmBranco(cursor);
+    const char *inicio = cursor.atual;
+    string_view palavra = lerPalavra(cursor);
+    if (palavra == secao)
+    {
+        pularLinha(cursor);
+        return true;
+    }
+
+    cursor.atual = inicio;
+    if (quantidade == 0)
+    {
+        return false;
+    }
+    erro(cursor, "esperada a seção " + string(secao) + ", encontrado '" + string(palavra) + "'");
+}
+
+// Consome "<chave>:" no início de uma linha de cabeçalho
+void LeitorArquivo::lerRotulo(CursorTexto &cursor, string_view chave)
+{
+    pularLinhasEmBranco(cursor);
+    size_t restante = cursor.fim - cursor.atual;
+    if (restante <= chave.size() || string_view(cursor.atual, chave.size()) != chave || cursor.atual[chave.size()] != ':')
+    {
+        erro(cursor, "esperado o campo '" + string(chave) + ":' do cabeçalho");
+    }
+    cursor.atual += chave.size() + 1;
+    pularEspacos(cursor);
+}
+
+int LeitorArquivo::lerInteiro(CursorTexto &cursor, const char *campo)
 {
-    pularAteSecao(arquivo, "ARC");
-    cout << "Lendo arcos não requeridos..." << endl;
-    
-    string linha;
-    getline(arquivo, linha); // Pular linha em branco
-    
-    while (getline(arquivo, linha) && !linha.empty())
+    pularEspacos(cursor);
+    int valor = 0;
+    auto [fim_numero, codigo] = from_chars(cursor.atual, cursor.fim, valor);
+    bool separado = fim_numero == cursor.fim || *fim_numero == ' ' || *fim_numero == '\t' ||
+                    *fim_numero == '\r' || *fim_numero == '\n';
+    if (codigo == errc::result_out_of_range)
+    {
+        erro(cursor, string("valor fora do intervalo em ") + campo);
+    }
+    if (codigo != errc() || !separado)
     {
-        if (linha.find_first_not_of(" \t\n\r") == string::npos)
+        string encontrado(lerPalavra(cursor));
+        if (encontrado.empty())
         {
-            continue;
+            erro(cursor, string("campo ") + campo + " ausente");
         }
+        erro(cursor, string("esperado inteiro em ") + campo + ", encontrado '" + encontrado + "'");
+    }
+    cursor.atual = fim_numero;
+    return valor;
+}
 
-        stringstream ss(linha);
-        string arc_name;
-        int u, v;
-        double custo_travessia;
+int LeitorArquivo::lerVertice(CursorTexto &cursor, const DadosGrafo &dados, const char *campo)
+{
+    int v = lerInteiro(cursor, campo);
+    if (v < 1 || v > dados.num_vertices)
+    {
+        erro(cursor, "vértice " + to_string(v) + " fora do intervalo 1.." + to_string(dados.num_vertices) +
+                         " em " + campo);
+    }
+    return v;
+}
+
+// Próxima sequência sem espaços na linha atual (vazia no fim da linha)
+string_view LeitorArquivo::lerPalavra(CursorTexto &cursor)
+{
+    pularEspacos(cursor);
+    const char *inicio = cursor.atual;
+    while (cursor.atual < cursor.fim && *cursor.atual != ' ' && *cursor.atual != '\t' &&
+           *cursor.atual != '\r' && *cursor.atual != '\n')
+    {
+        cursor.atual++;
+    }
+    return string_view(inicio, cursor.atual - inicio);
+}
 
-        if (!(ss >> arc_name >> u >> v >> custo_travessia))
+void LeitorArquivo::pularEspacos(CursorTexto &cursor)
+{
+    while (cursor.atual < cursor.fim && (*cursor.atual == ' ' || *cursor.atual == '\t' || *cursor.atual == '\r'))
+    {
+        cursor.atual++;
+    }
+}
+
+void LeitorArquivo::pularLinhasEmBranco(CursorTexto &cursor)
+{
+    while (true)
+    {
+        pularEspacos(cursor);
+        if (cursor.atual == cursor.fim || *cursor.atual != '\n')
         {
-            continue; // Linha mal formatada, pular
+            return;
         }
+        cursor.atual++;
+        cursor.linha++;
+    }
+}
 
-        dados.arcos.push_back({u, v});
-        dados.adj[u].push_back({v, custo_travessia});
+void LeitorArquivo::pularLinha(CursorTexto &cursor)
+{
+    while (cursor.atual < cursor.fim && *cursor.atual != '\n')
+    {
+        cursor.atual++;
+    }
+    if (cursor.atual < cursor.fim)
+    {
+        cursor.atual++;
+        cursor.linha++;
     }
 }
 
-void LeitorArquivo::pularAteSecao(ifstream &arquivo, const string &secao)
+// Exige que o resto da linha esteja vazio e passa para a próxima
+void LeitorArquivo::terminarLinha(CursorTexto &cursor)
 {
-    string linha;
-    while (getline(arquivo, linha) && linha.find(secao) == string::npos)
-        ;
-}
\ No newline at end of file
+    pularEspacos(cursor);
+    if (cursor.atual < cursor.fim && *cursor.atual != '\n')
+    {
+        string sobra(lerPalavra(cursor));
+        erro(cursor, "conteúdo inesperado no fim da linha: '" + sobra + "'");
+    }
+    pularLinha(cursor);
+}
+
+void LeitorArquivo::erro(const CursorTexto &cursor, const string &mensagem)
+{
+    throw runtime_error(*cursor.arquivo + ":" + to_string(cursor.linha) + ": " + mensagem);
+}
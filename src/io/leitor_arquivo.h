@@ -2,28 +2,56 @@
 #define LEITOR_ARQUIVO_H
 
 #include "estruturas_grafo.h"
-#include <fstream>
-#include <sstream>
+#include <string_view>
 
+// Posição de leitura sobre o texto (mapeado) de uma instância
+struct CursorTexto
+{
+    const char *atual;
+    const char *fim;
+    int linha;             // Linha atual, a partir de 1 (para mensagens de erro)
+    const string *arquivo;
+};
+
+// Leitor das instâncias .dat. O arquivo é mapeado em memória e percorrido uma
+// única vez por um tokenizador próprio, sem cópias de linhas nem streams; os
+// vetores são dimensionados pelas contagens do cabeçalho. Linhas mal formadas
+// geram runtime_error com o arquivo e o número da linha.
 class LeitorArquivo
 {
 public:
     static DadosGrafo lerArquivoDados(const string &nome_arquivo);
 
+    // Lê só as linhas de cabeçalho (contagens de vértices, ligações e serviços)
+    static ResumoInstancia lerResumoInstancia(const string &nome_arquivo);
+
 private:
-    static void lerCabecalho(ifstream &arquivo, DadosGrafo &dados);
-    static void lerQuantidadesRequeridas(ifstream &arquivo, int &num_vertices_req,
+    static void lerCabecalho(CursorTexto &cursor, DadosGrafo &dados, int &num_arestas, int &num_arcos);
+    static void lerQuantidadesRequeridas(CursorTexto &cursor, int &num_vertices_req,
                                          int &num_arestas_req, int &num_arcos_req);
-    static void lerNosRequeridos(ifstream &arquivo, DadosGrafo &dados,
+    static void lerNosRequeridos(CursorTexto &cursor, DadosGrafo &dados,
                                  int num_vertices_requeridos, int &id_servico);
-    static void lerArestasRequeridas(ifstream &arquivo, DadosGrafo &dados,
+    static void lerArestasRequeridas(CursorTexto &cursor, DadosGrafo &dados, vector<LigacaoCSR> &ligacoes,
                                      int num_arestas_requeridas, int &id_servico);
-    static void lerArestasNaoRequeridas(ifstream &arquivo, DadosGrafo &dados);
-    static void lerArcosRequeridos(ifstream &arquivo, DadosGrafo &dados,
+    static void lerArestasNaoRequeridas(CursorTexto &cursor, DadosGrafo &dados, vector<LigacaoCSR> &ligacoes,
+                                        int num_arestas_nao_requeridas);
+    static void lerArcosRequeridos(CursorTexto &cursor, DadosGrafo &dados, vector<LigacaoCSR> &ligacoes,
                                    int num_arcos_requeridos, int &id_servico);
-    static void lerArcosNaoRequeridos(ifstream &arquivo, DadosGrafo &dados);
-    static void pularAteSecao(ifstream &arquivo, const string &secao);
+    static void lerArcosNaoRequeridos(CursorTexto &cursor, DadosGrafo &dados, vector<LigacaoCSR> &ligacoes,
+                                      int num_arcos_nao_requeridos);
     static void inicializarVertices(DadosGrafo &dados);
+
+    // Tokenizador
+    static bool abrirSecao(CursorTexto &cursor, string_view secao, int quantidade);
+    static void lerRotulo(CursorTexto &cursor, string_view chave);
+    static int lerInteiro(CursorTexto &cursor, const char *campo);
+    static int lerVertice(CursorTexto &cursor, const DadosGrafo &dados, const char *campo);
+    static string_view lerPalavra(CursorTexto &cursor);
+    static void pularEspacos(CursorTexto &cursor);
+    static void pularLinhasEmBranco(CursorTexto &cursor);
+    static void pularLinha(CursorTexto &cursor);
+    static void terminarLinha(CursorTexto &cursor);
+    [[noreturn]] static void erro(const CursorTexto &cursor, const string &mensagem);
 };
 
-#endif // LEITOR_ARQUIVO_H
\ No newline at end of file
+#endif // LEITOR_ARQUIVO_H
@@ -2,6 +2,11 @@
 #include "etapas/etapa1.h"
 #include "etapas/etapa2.h"
 #include "etapas/etapa3.h"
+#include "etapas/pipeline.h"
+#include "etapas/benchmark.h"
+#include "etapas/lote.h"
+#include "core/paralelo.h"
+#include "core/registro.h"
 #include <iostream>
 #include <string>
 
@@ -14,8 +19,16 @@ void mostrarMenu()
     cout << "=======================================" << endl;
     cout << "1. Etapa 1 - Análise de Métricas dos Grafos" << endl;
     cout << "2. Etapa 2 - Geração de Soluções Iniciais" << endl;
-    cout << "3. Etapa 3 - Otimização com 2-opt" << endl;
+    cout << "3. Etapa 3 - Otimização por Busca Local" << endl;
+    cout << "4. Pipeline Completo (Etapas 1, 2 e 3 com uma leitura por instância)" << endl;
+    cout << "5. Benchmark de Escalabilidade (Floyd-Warshall)" << endl;
+    cout << "6. Configurar Número de Threads (atual: " << obterNumThreads() << ")" << endl;
+    cout << "7. Configurar Motor e Largura dos Caminhos Mínimos" << endl;
+    cout << "8. Configurar Intermediação (exata ou amostrada)" << endl;
     cout << "9. Informações sobre as Etapas" << endl;
+    cout << "10. Cache de Caminhos Mínimos em Disco (atual: "
+         << (Grafo::obterCacheCaminhos() ? "ativo" : "inativo") << ")" << endl;
+    cout << "11. Configurar Nível das Mensagens (atual: " << static_cast<int>(obterNivelRegistro()) << ")" << endl;
     cout << "0. Sair" << endl;
     cout << "=======================================" << endl;
     cout << "Escolha uma opção: ";
@@ -26,7 +39,7 @@ void mostrarInformacoes()
     cout << "\n=== INFORMAÇÕES DAS ETAPAS ===" << endl;
     cout << "\nETAPA 1 - Análise de Métricas:" << endl;
     cout << "- Calcula densidade, graus, caminho médio, diâmetro" << endl;
-    cout << "- Calcula centralidade de intermediação" << endl;
+    cout << "- Calcula centralidade de intermediação (exata ou amostrada, opção 8)" << endl;
     cout << "- Gera arquivos CSV com resultados" << endl;
     cout << "- Processa todos os arquivos .dat do diretório" << endl;
     
@@ -36,19 +49,43 @@ void mostrarInformacoes()
     cout << "- Respeita capacidade dos veículos" << endl;
     cout << "- Salva soluções em formato específico" << endl;
     
-    cout << "\nETAPA 3 - Otimização com 2-opt:" << endl;
-    cout << "- Aprimora as soluções da Etapa 2" << endl;
-    cout << "- Usa algoritmo de busca local 2-opt" << endl;
-    cout << "- Melhora o custo das rotas individualmente" << endl;
+    cout << "\nETAPA 3 - Otimização por Busca Local:" << endl;
+    cout << "- Aprimora as soluções da Etapa 2 (lidas de solucao/, sem reconstruir)" << endl;
+    cout << "- Parte da melhor solução já obtida (melhores_solucoes/), se houver" << endl;
+    cout << "- Dentro de cada rota: 2-opt, Or-opt e sentido ótimo das arestas" << endl;
+    cout << "- Entre rotas: relocate, swap, 2-opt* e CROSS-exchange (serviços mudam de veículo)" << endl;
+    cout << "- Alterna as buscas até que nenhuma melhore; rotas vazias são removidas" << endl;
     cout << "- Mantém todas as restrições de capacidade" << endl;
     cout << "- Gera estatísticas de melhoria" << endl;
+
+    cout << "\nBENCHMARK DE ESCALABILIDADE:" << endl;
+    cout << "- Mede o Floyd-Warshall paralelo de 1 até N threads" << endl;
+    cout << "- Usa as instâncias DI-NEARP-n833 do diretório de dados" << endl;
+    cout << "- Gera resultados_escalabilidade_fw.csv" << endl;
     cout << "\nPressione Enter para continuar...";
     cin.ignore();
     cin.get();
 }
 
-int main()
+int main(int argc, char *argv[])
 {
+    // Com argumentos: execução sem menu (ver --ajuda)
+    if (argc > 1)
+    {
+        int codigo;
+        try
+        {
+            codigo = executarLinhaDeComando(argc, argv);
+        }
+        catch (const exception &e)
+        {
+            REGISTRO_ERRO("Erro: " << e.what());
+            codigo = 2;
+        }
+        descarregarRegistro();
+        return codigo;
+    }
+
     cout << "Bem-vindo ao Sistema de Análise de Grafos - GCC262" << endl;
     
     int opcao;
@@ -56,6 +93,7 @@ int main()
     
     while (continuar)
     {
+        descarregarRegistro(); // O menu só aparece depois das mensagens pendentes
         mostrarMenu();
         cin >> opcao;
         
@@ -69,7 +107,7 @@ int main()
                 }
                 catch (const exception& e)
                 {
-                    cerr << "Erro na Etapa 1: " << e.what() << endl;
+                    REGISTRO_ERRO("Erro na Etapa 1: " << e.what());
                 }
                 break;
                 
@@ -81,7 +119,7 @@ int main()
                 }
                 catch (const exception& e)
                 {
-                    cerr << "Erro na Etapa 2: " << e.what() << endl;
+                    REGISTRO_ERRO("Erro na Etapa 2: " << e.what());
                 }
                 break;
                 
@@ -93,13 +131,127 @@ int main()
                 }
                 catch (const exception& e)
                 {
-                    cerr << "Erro na Etapa 3: " << e.what() << endl;
+                    REGISTRO_ERRO("Erro na Etapa 3: " << e.what());
+                }
+                break;
+
+            case 4:
+                cout << "\n=== EXECUTANDO PIPELINE COMPLETO ===" << endl;
+                try 
+                {
+                    executarPipeline();
+                }
+                catch (const exception& e)
+                {
+                    REGISTRO_ERRO("Erro no pipeline: " << e.what());
+                }
+                break;
+
+            case 5:
+                cout << "\n=== EXECUTANDO BENCHMARK ===" << endl;
+                try 
+                {
+                    executarBenchmarkFloydWarshall();
+                }
+                catch (const exception& e)
+                {
+                    REGISTRO_ERRO("Erro no benchmark: " << e.what());
+                }
+                break;
+
+            case 6:
+            {
+                int num_threads;
+                cout << "Número de threads (0 = todos os núcleos): ";
+                cin >> num_threads;
+                definirNumThreads(num_threads);
+                cout << "Usando " << obterNumThreads() << " thread(s)." << endl;
+                break;
+            }
+
+            case 7:
+            {
+                int motor;
+                cout << "0 = Automático, 1 = Floyd-Warshall, 2 = Dijkstra por origem: ";
+                cin >> motor;
+                if (motor == 1)
+                    Grafo::definirMotorCaminhos(MotorCaminhos::FLOYD_WARSHALL);
+                else if (motor == 2)
+                    Grafo::definirMotorCaminhos(MotorCaminhos::DIJKSTRA);
+                else
+                    Grafo::definirMotorCaminhos(MotorCaminhos::AUTOMATICO);
+
+                int largura;
+                cout << "Largura das distâncias: 0 = Automática, 1 = 32 bits, 2 = 16 bits (se couber): ";
+                cin >> largura;
+                if (largura == 1)
+                    Grafo::definirLarguraDistancias(LarguraDistancias::BITS_32);
+                else if (largura == 2)
+                    Grafo::definirLarguraDistancias(LarguraDistancias::BITS_16);
+                else
+                    Grafo::definirLarguraDistancias(LarguraDistancias::AUTOMATICA);
+                break;
+            }
+
+            case 8:
+            {
+                int modo;
+                cout << "0 = Exata (Brandes), 1 = Amostrada com garantia de erro: ";
+                cin >> modo;
+                if (modo != 1)
+                {
+                    Grafo::definirIntermediacaoExata();
+                    break;
                 }
+
+                ParametrosAmostragem parametros;
+                cout << "Erro máximo epsilon (escala normalizada, ex.: 0.01): ";
+                cin >> parametros.epsilon;
+                cout << "Probabilidade de falha delta (ex.: 0.1): ";
+                cin >> parametros.delta;
+                cout << "Tempo limite por grafo em segundos (0 = sem limite): ";
+                cin >> parametros.tempo_limite;
+                if (parametros.epsilon <= 0 || parametros.delta <= 0 || parametros.delta >= 1)
+                {
+                    cout << "Parâmetros inválidos; mantendo a configuração anterior." << endl;
+                    break;
+                }
+                Grafo::definirIntermediacaoAmostrada(parametros);
                 break;
+            }
 
             case 9:
                 mostrarInformacoes();
                 break;
+
+            case 10:
+            {
+                int ativo;
+                cout << "Diretório: " << Grafo::obterDiretorioCacheCaminhos() << "/" << endl;
+                cout << "0 = Desativar, 1 = Ativar: ";
+                cin >> ativo;
+                Grafo::definirCacheCaminhos(ativo == 1);
+                cout << "Cache de caminhos " << (ativo == 1 ? "ativado" : "desativado") << "." << endl;
+                break;
+            }
+
+            case 11:
+            {
+                int nivel;
+                cout << "0 = Erros, 1 = Avisos, 2 = Informações, 3 = Depuração, 4 = Rastro: ";
+                cin >> nivel;
+                if (nivel < 0 || nivel > static_cast<int>(NivelRegistro::RASTRO))
+                {
+                    cout << "Nível inválido; mantendo o atual." << endl;
+                    break;
+                }
+                definirNivelRegistro(static_cast<NivelRegistro>(nivel));
+                if (nivel > NIVEL_REGISTRO_MAXIMO)
+                {
+                    cout << "Aviso: mensagens de rastro não foram compiladas (use -DNIVEL_REGISTRO_MAXIMO=4)." << endl;
+                }
+                break;
+            }
                 
             case 0:
                 cout << "Encerrando o programa..." << endl;
@@ -113,11 +265,13 @@ int main()
         
         if (continuar && opcao != 9)
         {
+            descarregarRegistro();
             cout << "\nPressione Enter para continuar...";
             cin.ignore();
             cin.get();
         }
     }
     
+    descarregarRegistro();
     return 0;
 }
\ No newline at end of file